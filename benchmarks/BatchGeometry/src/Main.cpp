@@ -0,0 +1,130 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#include <trajopt/constraint/detail/LinePointDistance.hpp>
+#include <trajopt/geometry/BatchGeometry.hpp>
+#include <trajopt/geometry/Rotation2.hpp>
+#include <trajopt/geometry/Translation2.hpp>
+
+#include "Benchmark.hpp"
+
+// Compares the batch geometry kernels with the same computation done one
+// element at a time with the scalar geometry templates, on arrays the size of a
+// long trajectory's columns.
+
+namespace {
+
+constexpr size_t kCount = 100'000;
+constexpr int kRuns = 200;
+
+/**
+ * Times a scalar and a batch version of a computation, and prints both and
+ * the speedup of the medians.
+ */
+template <typename Scalar, typename Batch>
+void Run(std::string_view name, Scalar&& scalar, Batch&& batch) {
+  trajopt::benchmark::LatencyRecorder scalarLatency;
+  trajopt::benchmark::LatencyRecorder batchLatency;
+  for (int run = 0; run < kRuns; ++run) {
+    scalarLatency.Time(scalar);
+    batchLatency.Time(batch);
+  }
+
+  auto scalarStats = scalarLatency.Stats();
+  auto batchStats = batchLatency.Stats();
+  std::printf("%.*s\n", static_cast<int>(name.size()), name.data());
+  trajopt::benchmark::PrintLatency("  Scalar", scalarStats);
+  trajopt::benchmark::PrintLatency("  Batch", batchStats);
+  std::printf("  Speedup %.2fx\n", scalarStats.median / batchStats.median);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("Batch instruction set: %.*s\n\n",
+              static_cast<int>(trajopt::BatchInstructionSet().size()),
+              trajopt::BatchInstructionSet().data());
+
+  std::vector<double> x(kCount);
+  std::vector<double> y(kCount);
+  std::vector<double> radians(kCount);
+  std::vector<double> cos(kCount);
+  std::vector<double> sin(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    x[i] = std::fmod(0.37 * i, 16.0);
+    y[i] = std::fmod(0.53 * i, 8.0);
+    radians[i] = std::fmod(0.01 * i, 6.0) - 3.0;
+    cos[i] = std::cos(radians[i]);
+    sin[i] = std::sin(radians[i]);
+  }
+
+  std::vector<double> outX(kCount);
+  std::vector<double> outY(kCount);
+
+  // Each timed function returns an output element so it isn't optimized away
+  Run(
+      "Rotate points",
+      [&] {
+        for (size_t i = 0; i < kCount; ++i) {
+          auto rotated = trajopt::Translation2d{x[i], y[i]}.RotateBy(
+              trajopt::Rotation2d{cos[i], sin[i]});
+          outX[i] = rotated.X();
+          outY[i] = rotated.Y();
+        }
+        return outX.back();
+      },
+      [&] {
+        trajopt::BatchRotateBy(x, y, cos, sin, outX, outY);
+        return outX.back();
+      });
+
+  trajopt::Translation2d lineStart{2.0, 1.0};
+  trajopt::Translation2d lineEnd{12.0, 6.0};
+  Run(
+      "Line-point squared distance",
+      [&] {
+        trajopt::detail::LineSegment<double> line{lineStart, lineEnd};
+        for (size_t i = 0; i < kCount; ++i) {
+          outX[i] = trajopt::detail::LinePointSquaredDistance(
+              line, trajopt::Translation2d{x[i], y[i]});
+        }
+        return outX.back();
+      },
+      [&] {
+        trajopt::BatchLinePointSquaredDistance(lineStart, lineEnd, x, y, outX);
+        return outX.back();
+      });
+
+  Run(
+      "Cosine and sine to radians",
+      [&] {
+        for (size_t i = 0; i < kCount; ++i) {
+          outX[i] = trajopt::Rotation2d{cos[i], sin[i]}.Radians();
+        }
+        return outX.back();
+      },
+      [&] {
+        trajopt::BatchRadians(cos, sin, outX);
+        return outX.back();
+      });
+
+  Run(
+      "Radians to cosine and sine",
+      [&] {
+        for (size_t i = 0; i < kCount; ++i) {
+          trajopt::Rotation2d rotation{radians[i]};
+          outX[i] = rotation.Cos();
+          outY[i] = rotation.Sin();
+        }
+        return outX.back();
+      },
+      [&] {
+        trajopt::BatchCosSin(radians, outX, outY);
+        return outX.back();
+      });
+}
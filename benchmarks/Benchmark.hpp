@@ -0,0 +1,91 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace trajopt::benchmark {
+
+/**
+ * Latency statistics of repeated calls, in milliseconds.
+ */
+struct LatencyStats {
+  /// The number of calls.
+  size_t count = 0;
+
+  /// The fastest call.
+  double min = 0.0;
+
+  /// The median call.
+  double median = 0.0;
+
+  /// The 99th percentile call.
+  double p99 = 0.0;
+
+  /// The slowest call.
+  double max = 0.0;
+};
+
+/**
+ * Records how long calls take.
+ */
+class LatencyRecorder {
+ public:
+  /**
+   * Calls a function and records how long it took.
+   *
+   * @param function The function, which must return a value.
+   * @return The function's return value.
+   */
+  template <typename F>
+  auto Time(F&& function) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = function();
+    auto end = std::chrono::steady_clock::now();
+    m_latencies.push_back(
+        std::chrono::duration<double, std::milli>{end - start}.count());
+    return result;
+  }
+
+  /**
+   * Returns the latency statistics of the recorded calls.
+   */
+  LatencyStats Stats() const {
+    LatencyStats stats;
+    if (m_latencies.empty()) {
+      return stats;
+    }
+
+    auto latencies = m_latencies;
+    std::sort(latencies.begin(), latencies.end());
+    stats.count = latencies.size();
+    stats.min = latencies.front();
+    stats.median = latencies[latencies.size() / 2];
+    stats.p99 = latencies[(latencies.size() - 1) * 99 / 100];
+    stats.max = latencies.back();
+    return stats;
+  }
+
+ private:
+  std::vector<double> m_latencies;
+};
+
+/**
+ * Prints latency statistics as one row of a table.
+ *
+ * @param name The name of what was timed.
+ * @param stats The latency statistics.
+ */
+inline void PrintLatency(std::string_view name, const LatencyStats& stats) {
+  std::printf("%-32.*s %6zu calls  min %8.3f ms  median %8.3f ms  p99 %8.3f ms"
+              "  max %8.3f ms\n",
+              static_cast<int>(name.size()), name.data(), stats.count,
+              stats.min, stats.median, stats.p99, stats.max);
+}
+
+}  // namespace trajopt::benchmark
@@ -0,0 +1,41 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <trajopt/constraint/LinearVelocityMaxMagnitudeConstraint.hpp>
+#include <trajopt/drivetrain/SwerveDrivetrain.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+namespace trajopt::benchmark {
+
+/**
+ * Returns the drivetrain the benchmarks use: 45 kg, with four modules at the
+ * corners of a 1.2 m square.
+ */
+inline SwerveDrivetrain Drivetrain() {
+  return {.mass = 45,
+          .moi = 6,
+          .modules = {{{+0.6, +0.6}, 0.04, 70, 2},
+                      {{+0.6, -0.6}, 0.04, 70, 2},
+                      {{-0.6, +0.6}, 0.04, 70, 2},
+                      {{-0.6, -0.6}, 0.04, 70, 2}}};
+}
+
+/**
+ * Returns the path most benchmarks solve: from rest at the origin, through
+ * (3 m, 2 m), to rest at (6 m, 0 m) and 1.5 rad, with 30 control intervals per
+ * segment.
+ */
+inline SwervePathBuilder AutoPath() {
+  SwervePathBuilder path;
+  path.SetDrivetrain(Drivetrain());
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.TranslationWpt(1, 3.0, 2.0, 0.0);
+  path.PoseWpt(2, 6.0, 0.0, 1.5);
+  path.WptConstraint(0, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.WptConstraint(2, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.ControlIntervalCounts({30, 30});
+  return path;
+}
+
+}  // namespace trajopt::benchmark
@@ -0,0 +1,67 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Compares how long a solve takes without callbacks, with a slow callback on
+// the solver's thread, and with the same callback on a thread of its own, and
+// how many updates the callback thread delivered and dropped.
+
+namespace {
+
+/// How long the slow callback takes, like a UI redrawing a plot.
+constexpr std::chrono::milliseconds kCallbackDuration{5};
+
+trajopt::SwervePathBuilder MakePath() {
+  auto path = trajopt::benchmark::AutoPath();
+
+  // Report every iteration so the callback's cost is fully exposed
+  path.SetCallbackRate(std::numeric_limits<double>::infinity());
+  return path;
+}
+
+void Run(std::string_view name, const trajopt::SwervePathBuilder& path) {
+  constexpr int kRuns = 5;
+
+  trajopt::benchmark::LatencyRecorder latency;
+  trajopt::CallbackCounters counters;
+  for (int run = 0; run < kRuns; ++run) {
+    trajopt::SwerveTrajectoryGenerator generator{path};
+    auto solution = latency.Time([&] { return generator.Generate(); });
+    if (!solution) {
+      std::printf("%.*s failed: %s\n", static_cast<int>(name.size()),
+                  name.data(), solution.error().c_str());
+      return;
+    }
+    counters = generator.GetCallbackCounters();
+  }
+
+  trajopt::benchmark::PrintLatency(name, latency.Stats());
+  std::printf("%-32s %6llu delivered  %6llu dropped\n", "",
+              static_cast<unsigned long long>(counters.delivered),
+              static_cast<unsigned long long>(counters.dropped));
+}
+
+}  // namespace
+
+int main() {
+  auto path = MakePath();
+  Run("No callbacks", path);
+
+  path.AddIntermediateCallback([](trajopt::SwerveSolution&, int64_t) {
+    std::this_thread::sleep_for(kCallbackDuration);
+  });
+  Run("Slow callback, solver thread", path);
+
+  path.SetCallbackThread(true);
+  Run("Slow callback, own thread", path);
+}
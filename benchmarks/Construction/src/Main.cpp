@@ -0,0 +1,78 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Measures how long building and destroying the problem for a 200-waypoint path
+// takes, as in batch services that create many generators, and the process's
+// peak resident set size afterward.
+
+namespace {
+
+constexpr size_t kWaypointCount = 200;
+
+trajopt::SwervePathBuilder MakePath() {
+  trajopt::SwervePathBuilder path;
+  path.SetDrivetrain(trajopt::benchmark::Drivetrain());
+
+  // Weave back and forth across the field
+  for (size_t wpt = 0; wpt < kWaypointCount; ++wpt) {
+    double t = static_cast<double>(wpt);
+    path.PoseWpt(wpt, 0.5 * t, 2.0 * std::sin(0.5 * t), 0.1 * t);
+  }
+  path.ControlIntervalCounts(std::vector<size_t>(kWaypointCount - 1, 8));
+  return path;
+}
+
+/// Returns the peak resident set size in MiB, or NAN if it's unavailable.
+double PeakRssMiB() {
+#if defined(__unix__) || defined(__APPLE__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    // Bytes on macOS
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    // KiB elsewhere
+    return usage.ru_maxrss / 1024.0;
+#endif
+  }
+#endif
+  return NAN;
+}
+
+}  // namespace
+
+int main() {
+  constexpr int kRuns = 20;
+
+  auto path = MakePath();
+
+  trajopt::benchmark::LatencyRecorder construction;
+  trajopt::benchmark::LatencyRecorder teardown;
+  for (int run = 0; run < kRuns; ++run) {
+    auto generator = construction.Time([&] {
+      return std::make_unique<trajopt::SwerveTrajectoryGenerator>(path);
+    });
+    teardown.Time([&] {
+      generator.reset();
+      return 0;
+    });
+  }
+
+  trajopt::benchmark::PrintLatency("Construction", construction.Stats());
+  trajopt::benchmark::PrintLatency("Teardown", teardown.Stats());
+  std::printf("%-32s %.1f MiB\n", "Peak RSS", PeakRssMiB());
+}
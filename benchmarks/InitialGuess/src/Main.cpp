@@ -0,0 +1,103 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/geometry/Pose2.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/solution/SwerveSolution.hpp>
+#include <trajopt/util/GenerateLinearInitialGuess.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Compares the straight-line initial guess the generator used to start from
+// with the current one, which routes around segment obstacles, follows a
+// spline through the guess points, and is time-parameterized: how long each
+// takes to build, and how many solver iterations and how long the solve
+// takes from each.
+
+namespace {
+
+constexpr int kRuns = 5;
+
+/// A path and the waypoint poses the straight-line guess connects.
+struct Case {
+  std::string_view name;
+  trajopt::SwervePathBuilder path;
+  std::vector<std::vector<trajopt::Pose2d>> guessPoints;
+};
+
+trajopt::SwervePathBuilder MakePath() {
+  auto path = trajopt::benchmark::AutoPath();
+  path.AddBumpers(trajopt::Bumpers{.safetyDistance = 0.1,
+                                   .points = {{+0.5, +0.5},
+                                              {-0.5, +0.5},
+                                              {-0.5, -0.5},
+                                              {+0.5, -0.5}}});
+  return path;
+}
+
+/**
+ * Times building a guess and solving from it, and prints both with the
+ * solve's iteration count.
+ */
+template <typename MakeGuess>
+void Run(std::string_view name, const trajopt::SwervePathBuilder& path,
+         MakeGuess&& makeGuess) {
+  trajopt::benchmark::LatencyRecorder guessLatency;
+  trajopt::benchmark::LatencyRecorder solveLatency;
+  int iterations = 0;
+  for (int run = 0; run < kRuns; ++run) {
+    auto guess = guessLatency.Time(makeGuess);
+    auto solution = solveLatency.Time([&] {
+      return trajopt::SwerveTrajectoryGenerator{path, guess}.Generate();
+    });
+    if (!solution) {
+      std::printf("  %.*s failed: %s\n", static_cast<int>(name.size()),
+                  name.data(), solution.error().c_str());
+      return;
+    }
+    iterations = solution->iterations;
+  }
+
+  std::printf("  %.*s\n", static_cast<int>(name.size()), name.data());
+  trajopt::benchmark::PrintLatency("    Guess", guessLatency.Stats());
+  trajopt::benchmark::PrintLatency("    Solve", solveLatency.Stats());
+  std::printf("    %d iterations\n", iterations);
+}
+
+}  // namespace
+
+int main() {
+  std::vector<trajopt::Pose2d> waypoints{
+      {0.0, 0.0, 0.0}, {3.0, 2.0, 0.0}, {6.0, 0.0, 1.5}};
+  std::vector<std::vector<trajopt::Pose2d>> guessPoints;
+  for (const auto& waypoint : waypoints) {
+    guessPoints.push_back({waypoint});
+  }
+
+  std::vector<Case> cases;
+  cases.push_back({"Open field", MakePath(), guessPoints});
+
+  // An obstacle on the straight line between the first two waypoints
+  auto blocked = MakePath();
+  blocked.SgmtObstacle(
+      0, 1, trajopt::Obstacle{.safetyDistance = 0.3, .points = {{1.5, 1.0}}});
+  cases.push_back({"Obstacle on the straight line", blocked, guessPoints});
+
+  for (const auto& testCase : cases) {
+    const auto& path = testCase.path;
+    std::printf("%.*s\n", static_cast<int>(testCase.name.size()),
+                testCase.name.data());
+    Run("Straight line", path, [&] {
+      return trajopt::GenerateLinearInitialGuess<trajopt::SwerveSolution>(
+          testCase.guessPoints, path.GetControlIntervalCounts());
+    });
+    Run("Routed spline, time-parameterized", path,
+        [&] { return path.CalculateInitialGuess(); });
+  }
+}
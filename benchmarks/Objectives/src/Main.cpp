@@ -0,0 +1,67 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstdio>
+#include <numeric>
+#include <string_view>
+
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Compares how many solver iterations and how long each objective takes on the
+// same path, and the total time of the trajectory each one finds.
+
+namespace {
+
+void Run(std::string_view name, const trajopt::SwervePathBuilder& path) {
+  constexpr int kRuns = 5;
+
+  trajopt::benchmark::LatencyRecorder latency;
+  int iterations = 0;
+  double totalTime = 0.0;
+  for (int run = 0; run < kRuns; ++run) {
+    auto solution = latency.Time(
+        [&] { return trajopt::SwerveTrajectoryGenerator{path}.Generate(); });
+    if (!solution) {
+      std::printf("%.*s failed: %s\n", static_cast<int>(name.size()),
+                  name.data(), solution.error().c_str());
+      return;
+    }
+    iterations = solution->iterations;
+    totalTime =
+        std::accumulate(solution->dt.begin(), solution->dt.end(), 0.0);
+  }
+
+  trajopt::benchmark::PrintLatency(name, latency.Stats());
+  std::printf("%-32s %6d iterations  total time %.3f s\n", "", iterations,
+              totalTime);
+}
+
+}  // namespace
+
+int main() {
+  auto path = trajopt::benchmark::AutoPath();
+  Run("Minimum time", path);
+
+  path.SetObjective(trajopt::TimeAndJerkObjective{});
+  Run("Time and jerk", path);
+
+  // Arrive a second later than the minimum time allows with as little effort
+  // as possible
+  auto minimumTime =
+      trajopt::SwerveTrajectoryGenerator{trajopt::benchmark::AutoPath()}
+          .Generate();
+  if (!minimumTime) {
+    std::printf("Minimum time generation failed: %s\n",
+                minimumTime.error().c_str());
+    return 1;
+  }
+  path.SetObjective(trajopt::MinimumForceObjective{});
+  path.TotalTime(
+      std::accumulate(minimumTime->dt.begin(), minimumTime->dt.end(), 0.0) +
+      1.0);
+  Run("Minimum force, fixed time", path);
+}
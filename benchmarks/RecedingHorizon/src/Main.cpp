@@ -0,0 +1,90 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <numeric>
+
+#include <trajopt/RecedingHorizonSwerveTrajectoryGenerator.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Measures how long replanning the rest of an auto takes after the robot is
+// bumped, which has to fit in one 20 ms control loop. The robot follows each
+// plan for a quarter second, then is bumped sideways and replans, until it
+// reaches the end.
+
+int main() {
+  trajopt::SwervePathBuilder path;
+  path.SetDrivetrain(trajopt::benchmark::Drivetrain());
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.TranslationWpt(1, 3.0, 2.0, 0.0);
+  path.TranslationWpt(2, 6.0, 0.0, 0.0);
+  path.PoseWpt(3, 8.0, 1.0, 1.5);
+  path.WptConstraint(0, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.WptConstraint(3, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.ControlIntervalCounts({30, 30, 30});
+
+  auto reference = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  if (!reference) {
+    std::printf("Reference generation failed: %s\n", reference.error().c_str());
+    return 1;
+  }
+
+  constexpr int kRuns = 10;
+  constexpr double kReplanPeriod = 0.25;
+  constexpr int kMaxReplansPerRun = 100;
+
+  trajopt::benchmark::LatencyRecorder latency;
+  size_t failures = 0;
+  size_t suboptimal = 0;
+
+  for (int run = 0; run < kRuns; ++run) {
+    trajopt::RecedingHorizonSwerveTrajectoryGenerator replanner{path,
+                                                                *reference};
+
+    // Stagger the bumps between runs
+    double time = kReplanPeriod * (run + 1) / kRuns;
+    for (int replan = 0; replan < kMaxReplansPerRun; ++replan) {
+      const auto& plan = replanner.Plan();
+      double planTime = std::accumulate(plan.dt.begin(), plan.dt.end(), 0.0);
+      if (time >= planTime) {
+        break;
+      }
+
+      // The plan's sample just before the current time
+      size_t index = 0;
+      double sampleTime = 0.0;
+      while (sampleTime + plan.dt[index] <= time) {
+        sampleTime += plan.dt[index];
+        ++index;
+      }
+
+      double bump = replan % 2 == 0 ? 0.05 : -0.05;
+      trajopt::HolonomicTrajectorySample measured{
+          time,
+          plan.x[index],
+          plan.y[index] + bump,
+          std::atan2(plan.thetasin[index], plan.thetacos[index]),
+          plan.vx[index],
+          plan.vy[index],
+          plan.omega[index]};
+
+      auto result = latency.Time([&] { return replanner.Replan(measured); });
+      if (!result) {
+        ++failures;
+        time += kReplanPeriod;
+      } else {
+        suboptimal += result->suboptimal ? 1 : 0;
+        time = kReplanPeriod;
+      }
+    }
+  }
+
+  auto stats = latency.Stats();
+  trajopt::benchmark::PrintLatency("RecedingHorizon replan", stats);
+  std::printf("%zu replans failed and %zu were suboptimal\n", failures,
+              suboptimal);
+}
@@ -0,0 +1,65 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstdio>
+#include <numeric>
+#include <string_view>
+
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "Benchmark.hpp"
+#include "BenchmarkPaths.hpp"
+
+// Compares the full and reduced transcriptions on the same paths: how long the
+// solve takes, how many solver iterations it needs and what each one costs, and
+// the total time of the trajectory each one finds.
+
+namespace {
+
+trajopt::SwervePathBuilder MakePath() {
+  auto path = trajopt::benchmark::AutoPath();
+  path.SgmtConstraint(0, 2,
+                      trajopt::LinearAccelerationMaxMagnitudeConstraint{8.0});
+  return path;
+}
+
+void Run(std::string_view name, trajopt::SwervePathBuilder path,
+         trajopt::Transcription transcription) {
+  constexpr int kRuns = 5;
+
+  path.SetTranscription(transcription);
+
+  trajopt::benchmark::LatencyRecorder latency;
+  int iterations = 0;
+  double totalTime = 0.0;
+  for (int run = 0; run < kRuns; ++run) {
+    auto solution = latency.Time(
+        [&] { return trajopt::SwerveTrajectoryGenerator{path}.Generate(); });
+    if (!solution) {
+      std::printf("%.*s failed: %s\n", static_cast<int>(name.size()),
+                  name.data(), solution.error().c_str());
+      return;
+    }
+    iterations = solution->iterations;
+    totalTime =
+        std::accumulate(solution->dt.begin(), solution->dt.end(), 0.0);
+  }
+
+  auto stats = latency.Stats();
+  trajopt::benchmark::PrintLatency(name, stats);
+  std::printf("%-32s %6d iterations  %.3f ms/iteration  total time %.3f s\n",
+              "", iterations, stats.median / iterations, totalTime);
+}
+
+}  // namespace
+
+int main() {
+  auto path = MakePath();
+  Run("Minimum time, full", path, trajopt::Transcription::kFull);
+  Run("Minimum time, reduced", path, trajopt::Transcription::kReduced);
+
+  path.SetObjective(trajopt::TimeAndJerkObjective{});
+  Run("Time and jerk, full", path, trajopt::Transcription::kFull);
+  Run("Time and jerk, reduced", path, trajopt::Transcription::kReduced);
+}
@@ -0,0 +1,200 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trajopt/GenerationOptions.hpp"
+#include "trajopt/path/Path.hpp"
+#include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/path/SwervePathSpec.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/CallbackCounters.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+/**
+ * Returns true if a waypoint's pose and velocity are fully pinned, which
+ * happens when its waypoint constraints include a PoseEqualityConstraint, a
+ * LinearVelocityMaxMagnitudeConstraint of zero, and an
+ * AngularVelocityMaxMagnitudeConstraint of zero.
+ *
+ * The parts of a path on either side of a pinned waypoint don't affect each
+ * other, so they can be solved separately.
+ *
+ * @param path The path.
+ * @param wptIndex The waypoint's index.
+ */
+TRAJOPT_DLLEXPORT bool IsWaypointPinned(const SwervePath& path,
+                                        size_t wptIndex);
+
+/**
+ * Options for the consensus iterations of DecomposedSwerveTrajectoryGenerator.
+ */
+struct TRAJOPT_DLLEXPORT DecompositionOptions {
+  /// The weight of the quadratic penalty on the pieces disagreeing about a
+  /// boundary state.
+  double penalty = 10.0;
+
+  /// The largest disagreement about any boundary state component allowed at
+  /// convergence.
+  double tolerance = 1e-4;
+
+  /// The maximum number of consensus iterations.
+  int maxIterations = 100;
+};
+
+/**
+ * Generates a swerve trajectory by splitting its path at waypoints and solving
+ * the pieces on separate threads.
+ *
+ * Pieces that meet at a pinned waypoint (see IsWaypointPinned()) are
+ * independent and are solved once. Pieces that meet at a waypoint that isn't
+ * pinned have to agree on the robot's pose and velocity there, so they're
+ * solved repeatedly with ADMM: each piece minimizes its objective plus an
+ * augmented Lagrangian penalty on its boundary states' distance from the
+ * consensus states, and the consensus states are then set to the average of
+ * the pieces'. Once the pieces agree to within tolerance, each piece is solved
+ * one last time with its boundary states fixed to the consensus, so the
+ * stitched trajectory is continuous.
+ *
+ * Splitting at waypoints that aren't pinned usually needs several rounds of
+ * solves, so it only pays off when the pieces are large and there are cores to
+ * spare.
+ *
+ * The path's intermediate callbacks receive the pieces' latest states stitched
+ * together, and are called from the threads solving the pieces.
+ */
+class TRAJOPT_DLLEXPORT DecomposedSwerveTrajectoryGenerator {
+ public:
+  /**
+   * Constructs a DecomposedSwerveTrajectoryGenerator.
+   *
+   * @param pathBuilder The path builder.
+   * @param splitWaypoints The indices of the interior waypoints to split the
+   *     path at.
+   * @param options The consensus iteration options.
+   * @param handle An identifier for state callbacks.
+   */
+  DecomposedSwerveTrajectoryGenerator(SwervePathBuilder pathBuilder,
+                                      std::vector<size_t> splitWaypoints,
+                                      DecompositionOptions options = {},
+                                      int64_t handle = 0);
+
+  /**
+   * Constructs a DecomposedSwerveTrajectoryGenerator that starts from the given
+   * initial guess instead of the path builder's.
+   *
+   * @param pathBuilder The path builder.
+   * @param initialGuess The initial guess. It must have one sample for each
+   *   sample of the path.
+   * @param splitWaypoints The indices of the interior waypoints to split the
+   *     path at.
+   * @param options The consensus iteration options.
+   * @param handle An identifier for state callbacks.
+   */
+  DecomposedSwerveTrajectoryGenerator(SwervePathBuilder pathBuilder,
+                                      SwerveSolution initialGuess,
+                                      std::vector<size_t> splitWaypoints,
+                                      DecompositionOptions options = {},
+                                      int64_t handle = 0);
+
+  /**
+   * Constructs a DecomposedSwerveTrajectoryGenerator for a shared path.
+   *
+   * @param spec The path. The generator keeps a reference to it.
+   * @param splitWaypoints The indices of the interior waypoints to split the
+   *     path at.
+   * @param options The consensus iteration options.
+   * @param handle An identifier for state callbacks.
+   */
+  DecomposedSwerveTrajectoryGenerator(
+      std::shared_ptr<const SwervePathSpec> spec,
+      std::vector<size_t> splitWaypoints, DecompositionOptions options = {},
+      int64_t handle = 0);
+
+  /**
+   * Constructs a DecomposedSwerveTrajectoryGenerator for a shared path that
+   * starts from the given initial guess instead of the path's.
+   *
+   * @param spec The path. The generator keeps a reference to it.
+   * @param initialGuess The initial guess. It must have one sample for each
+   *   sample of the path.
+   * @param splitWaypoints The indices of the interior waypoints to split the
+   *     path at.
+   * @param options The consensus iteration options.
+   * @param handle An identifier for state callbacks.
+   */
+  DecomposedSwerveTrajectoryGenerator(
+      std::shared_ptr<const SwervePathSpec> spec, SwerveSolution initialGuess,
+      std::vector<size_t> splitWaypoints, DecompositionOptions options = {},
+      int64_t handle = 0);
+
+  /**
+   * Generates an optimal trajectory.
+   *
+   * This function may take a long time to complete.
+   *
+   * @param diagnostics Enables diagnostic prints.
+   * @return Returns a holonomic trajectory for the whole path on success, or a
+   *   string containing a failure reason.
+   */
+  expected<SwerveSolution, std::string> Generate(bool diagnostics = false);
+
+  /**
+   * Generates a trajectory with the given solver options.
+   *
+   * Paths with total time constraints couple every piece, so they can't be
+   * split.
+   *
+   * The tolerance, iteration limit, and mode apply to each solve of each piece.
+   * The timeout covers the whole generation.
+   *
+   * @param options The solver options.
+   * @return Returns a holonomic trajectory for the whole path on success, or a
+   *   string containing a failure reason.
+   */
+  expected<SwerveSolution, std::string> Generate(
+      const GenerationOptions& options);
+
+  /**
+   * Adds a callback to retrieve the pieces' latest states stitched together,
+   * for this generator only.
+   *
+   * @param callback The callback.
+   */
+  void AddIntermediateCallback(
+      std::function<void(SwerveSolution&, int64_t)> callback) {
+    m_callbacks.push_back(std::move(callback));
+  }
+
+  /**
+   * Returns how many stitched intermediate solutions this generator's
+   * generations have sent to the path's callbacks, and how many a callback
+   * thread dropped.
+   */
+  CallbackCounters GetCallbackCounters() const { return m_callbackCounters; }
+
+ private:
+  std::shared_ptr<const SwervePathSpec> m_spec;
+
+  /// The path's intermediate callbacks, then the ones added to this generator
+  std::vector<std::function<void(SwerveSolution&, int64_t)>> m_callbacks;
+  std::optional<SwerveSolution> m_initialGuess;
+  std::vector<size_t> m_splitWaypoints;
+  DecompositionOptions m_options;
+  int64_t m_handle;
+  CallbackCounters m_callbackCounters;
+};
+
+}  // namespace trajopt
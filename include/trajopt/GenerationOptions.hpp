@@ -0,0 +1,97 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * What the solver looks for.
+ */
+enum class GenerationMode {
+  /// The trajectory that minimizes the path's objective.
+  kOptimal,
+
+  /// Any trajectory that satisfies every constraint. The objective isn't
+  /// minimized, so the solver stops as soon as it finds one.
+  kFeasible
+};
+
+/**
+ * Options for generating a trajectory.
+ */
+struct TRAJOPT_DLLEXPORT GenerationOptions {
+  /// The solver stops once the error is below this tolerance. 1e-4 is 0.1 mm.
+  double tolerance = 1e-4;
+
+  /// The maximum number of solver iterations before giving up.
+  int maxIterations = 5000;
+
+  /// The maximum time the solver may take before giving up.
+  std::chrono::duration<double> timeout{
+      std::numeric_limits<double>::infinity()};
+
+  /// What the solver looks for.
+  GenerationMode mode = GenerationMode::kOptimal;
+
+  /// Enables diagnostic prints.
+  bool diagnostics = false;
+
+  /// If true, a solve that times out, hits the iteration limit, or is canceled
+  /// returns the iterate it found with the lowest objective value, then the
+  /// lowest constraint violation, among those whose constraint violation is
+  /// within anytimeTolerance, flagged as suboptimal, instead of failing.
+  bool anytime = false;
+
+  /// The largest constraint violation an anytime result may have. The units
+  /// are those of the violated constraint.
+  double anytimeTolerance = 1e-3;
+
+  /// If set, the generation is canceled once this flag is true, like it is by
+  /// the global cancellation flag, but without affecting other generations.
+  const std::atomic<bool>* cancellation = nullptr;
+
+  /**
+   * Returns options for quick previews while a path is being edited.
+   *
+   * The trajectory is accurate to about a centimeter, which is plenty to draw,
+   * and the solver gives up early on paths that don't converge.
+   */
+  static constexpr GenerationOptions Preview() {
+    GenerationOptions options;
+    options.tolerance = 1e-2;
+    options.maxIterations = 500;
+    return options;
+  }
+
+  /**
+   * Returns options for replanning on a robot within one control loop.
+   *
+   * The solver stops after 15 ms and returns the best feasible iterate it found
+   * if it hasn't converged by then.
+   */
+  static constexpr GenerationOptions RealTime() {
+    GenerationOptions options;
+    options.tolerance = 1e-3;
+    options.maxIterations = 100;
+    options.timeout = std::chrono::duration<double>{0.015};
+    options.anytime = true;
+    return options;
+  }
+
+  /**
+   * Returns options for final trajectories that will be followed by a robot.
+   */
+  static constexpr GenerationOptions Export() {
+    GenerationOptions options;
+    options.tolerance = 1e-6;
+    return options;
+  }
+};
+
+}  // namespace trajopt
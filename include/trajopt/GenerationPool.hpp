@@ -0,0 +1,160 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trajopt/GenerationOptions.hpp"
+#include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/path/SwervePathSpec.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+class GenerationPool;
+
+/**
+ * A trajectory generation submitted to a GenerationPool.
+ *
+ * Every member function is thread-safe.
+ */
+class TRAJOPT_DLLEXPORT GenerationJob {
+ public:
+  /**
+   * Returns true once the generation has finished, successfully or not.
+   */
+  bool IsDone() const;
+
+  /**
+   * Cancels the generation. A job that hasn't started yet finishes without
+   * being solved, and a running one stops at its next solver iteration.
+   * Other jobs aren't affected.
+   */
+  void Cancel();
+
+  /**
+   * Returns the latest intermediate solution the solver reported, or nullopt if
+   * it hasn't reported one yet.
+   */
+  std::optional<SwerveSolution> Progress() const;
+
+  /**
+   * Blocks until the generation has finished, then returns its result.
+   *
+   * @return The trajectory on success, or a string containing a failure
+   *   reason.
+   */
+  const expected<SwerveSolution, std::string>& Wait();
+
+  /**
+   * Sets a function to call once the generation has finished, replacing the
+   * previous one. It's called from the pool's thread after the result is set,
+   * so Wait() may return before it runs, or immediately from this thread if
+   * the generation has already finished.
+   *
+   * @param callback The function.
+   */
+  void OnDone(std::function<void()> callback);
+
+ private:
+  friend class GenerationPool;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_doneCondition;
+  std::atomic<bool> m_canceled = false;
+
+  std::optional<SwerveSolution> m_progress;
+  std::optional<expected<SwerveSolution, std::string>> m_result;
+  std::function<void()> m_onDone;
+
+  void Finish(expected<SwerveSolution, std::string> result);
+};
+
+/**
+ * Runs trajectory generations on a fixed set of worker threads, so many
+ * concurrent generations share the machine's cores instead of each occupying
+ * a thread of its own.
+ */
+class TRAJOPT_DLLEXPORT GenerationPool {
+ public:
+  /**
+   * Constructs a GenerationPool and starts its threads.
+   *
+   * @param threadCount The number of worker threads. Zero means one per
+   *   hardware thread.
+   */
+  explicit GenerationPool(size_t threadCount = 0);
+
+  /**
+   * Cancels every unfinished job and waits for the worker threads to exit.
+   */
+  ~GenerationPool();
+
+  /**
+   * Queues a trajectory generation.
+   *
+   * The generator's problem is built on the worker thread too, so this returns
+   * right away. The path is solved whole on that thread, even if it has pinned
+   * waypoints a SwerveTrajectoryGenerator would split it at.
+   *
+   * @param pathBuilder The path builder. Pass it as an rvalue to avoid copying
+   *   it.
+   * @param options The solver options. Their cancellation flag is replaced by
+   *   the job's.
+   * @param handle An identifier for state callbacks.
+   * @return The job.
+   */
+  std::shared_ptr<GenerationJob> Submit(SwervePathBuilder pathBuilder,
+                                        GenerationOptions options = {},
+                                        int64_t handle = 0);
+
+  /**
+   * Queues a trajectory generation for a shared path. Jobs for the same path
+   * share one copy of it.
+   *
+   * @param spec The path.
+   * @param options The solver options. Their cancellation flag is replaced by
+   *   the job's.
+   * @param handle An identifier for state callbacks.
+   * @return The job.
+   */
+  std::shared_ptr<GenerationJob> Submit(
+      std::shared_ptr<const SwervePathSpec> spec,
+      GenerationOptions options = {}, int64_t handle = 0);
+
+ private:
+  struct Task {
+    std::shared_ptr<GenerationJob> job;
+    std::shared_ptr<const SwervePathSpec> spec;
+    GenerationOptions options;
+    int64_t handle = 0;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_taskCondition;
+  std::deque<Task> m_tasks;
+  bool m_stopping = false;
+
+  /// The job each worker thread is running, or nullptr if it's idle.
+  std::vector<std::shared_ptr<GenerationJob>> m_running;
+
+  std::vector<std::thread> m_threads;
+
+  void Work(size_t threadIndex);
+};
+
+}  // namespace trajopt
@@ -0,0 +1,117 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sleipnir/autodiff/Variable.hpp>
+
+#include "trajopt/GenerationOptions.hpp"
+#include "trajopt/SwerveTrajectoryGenerator.hpp"
+#include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/trajectory/HolonomicTrajectorySample.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+/**
+ * Replans the rest of a swerve trajectory from the robot's measured state
+ * while it's being followed, e.g., after the robot is bumped.
+ *
+ * Building a problem takes much longer than one control loop, so the problems
+ * are built up front: one for the rest of the path from within each segment.
+ * Each starts at a free state that's constrained to the measured state, which
+ * is set before each solve. The solver starts from the current plan shifted to
+ * the measured time, so it usually converges in a few iterations, and
+ * RealTime() options cap the time it may take.
+ *
+ * The waypoint constraints of the waypoint the robot last passed are dropped,
+ * since the robot is already past it. The path's total time constraints apply
+ * to what's left of the path, less the time already spent.
+ */
+class TRAJOPT_DLLEXPORT RecedingHorizonSwerveTrajectoryGenerator {
+ public:
+  /**
+   * Constructs a RecedingHorizonSwerveTrajectoryGenerator and builds its
+   * problems.
+   *
+   * @param pathBuilder The path builder.
+   * @param reference The solved trajectory for the whole path, which is the
+   *     initial plan.
+   * @param options The solver options for each replan.
+   */
+  RecedingHorizonSwerveTrajectoryGenerator(
+      const SwervePathBuilder& pathBuilder, SwerveSolution reference,
+      GenerationOptions options = GenerationOptions::RealTime());
+
+  ~RecedingHorizonSwerveTrajectoryGenerator();
+
+  /**
+   * Returns the current plan: the reference until a replan succeeds, then the
+   * latest replanned trajectory.
+   */
+  const SwerveSolution& Plan() const { return m_plan; }
+
+  /**
+   * Replans the rest of the path from the robot's measured state.
+   *
+   * On success, the replanned trajectory becomes the current plan, and it
+   * starts at the measured state.
+   *
+   * @param measured The robot's measured state. Its timestamp is the time (s)
+   *     since the start of the current plan.
+   * @return The replanned trajectory on success, or a string containing a
+   *     failure reason. The current plan is kept on failure.
+   */
+  expected<SwerveSolution, std::string> Replan(
+      const HolonomicTrajectorySample& measured);
+
+ private:
+  /// The problem for the rest of the path from within one segment.
+  struct Remainder {
+    std::unique_ptr<SwerveTrajectoryGenerator> generator;
+
+    /// Measured x, y, cos θ, sin θ, vx, vy, and ω, which the first sample is
+    /// constrained to.
+    std::array<sleipnir::Variable, 7> initialState;
+
+    /// What's left of the path's exact and largest total times (s) at the
+    /// measured time, which the remainder's total time is constrained to if
+    /// the path has them.
+    sleipnir::Variable remainingTime;
+    sleipnir::Variable remainingMaxTime;
+  };
+
+  std::vector<size_t> m_N;
+
+  /// The whole path's exact and largest total times (s).
+  std::optional<double> m_totalTime;
+  std::optional<double> m_maxTotalTime;
+
+  GenerationOptions m_options;
+  std::vector<Remainder> m_remainders;
+
+  SwerveSolution m_plan;
+
+  /// Index of the path segment the current plan starts in.
+  size_t m_planFirstSgmt = 0;
+
+  /// Time (s) since the start of the path at which the current plan starts.
+  double m_planStartTime = 0.0;
+
+  /// Time (s) of each sample of the current plan.
+  std::vector<double> m_planTimes;
+
+  void SetPlan(SwerveSolution plan, size_t firstSgmt);
+
+  SwerveSolution ShiftPlan(size_t sgmtIndex, double time) const;
+};
+
+}  // namespace trajopt
@@ -5,33 +5,89 @@
 #include <stdint.h>
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <sleipnir/optimization/OptimizationProblem.hpp>
 
+#include "trajopt/GenerationOptions.hpp"
 #include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/path/SwervePathSpec.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/CallbackCounters.hpp"
 #include "trajopt/util/SymbolExports.hpp"
 #include "trajopt/util/expected"
 
 namespace trajopt {
 
+class DecomposedSwerveTrajectoryGenerator;
+
+namespace detail {
+class CallbackReporter;
+}  // namespace detail
+
 /**
  * This trajectory generator class contains functions to generate
  * time-optimal trajectories for several drivetrain types.
+ *
+ * If any interior waypoints are pinned (see IsWaypointPinned()), the path is
+ * split at them and the independent pieces are solved concurrently by a
+ * DecomposedSwerveTrajectoryGenerator. The solution has the same form either
+ * way.
  */
 class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
  public:
   /**
    * Construct a new swerve trajectory optimization problem.
    *
-   * @param pathBuilder The path builder.
+   * @param pathBuilder The path builder. Pass it as an rvalue to avoid copying
+   *   it.
    * @param handle An identifier for state callbacks.
    */
   explicit SwerveTrajectoryGenerator(SwervePathBuilder pathBuilder,
                                      int64_t handle = 0);
 
+  /**
+   * Construct a new swerve trajectory optimization problem for a shared path.
+   *
+   * @param spec The path. The generator keeps a reference to it.
+   * @param handle An identifier for state callbacks.
+   */
+  explicit SwerveTrajectoryGenerator(std::shared_ptr<const SwervePathSpec> spec,
+                                     int64_t handle = 0);
+
+  /**
+   * Construct a new swerve trajectory optimization problem that starts from
+   * the given initial guess instead of the path builder's.
+   *
+   * This can warm start the solver from a previous solution of a similar path
+   * or from PrimitiveLibrary::InitialGuess().
+   *
+   * @param pathBuilder The path builder.
+   * @param initialGuess The initial guess. It must have one sample for each
+   *   sample of the path. If it has velocities, accelerations, and module
+   *   forces, they're used along with its dt; otherwise they're estimated from
+   *   its poses.
+   * @param handle An identifier for state callbacks.
+   */
+  SwerveTrajectoryGenerator(SwervePathBuilder pathBuilder,
+                            const SwerveSolution& initialGuess,
+                            int64_t handle = 0);
+
+  /**
+   * Construct a new swerve trajectory optimization problem for a shared path
+   * that starts from the given initial guess instead of the path's.
+   *
+   * @param spec The path. The generator keeps a reference to it.
+   * @param initialGuess The initial guess. See the overload taking a path
+   *   builder.
+   * @param handle An identifier for state callbacks.
+   */
+  SwerveTrajectoryGenerator(std::shared_ptr<const SwervePathSpec> spec,
+                            const SwerveSolution& initialGuess,
+                            int64_t handle = 0);
+
   /**
    * Generates an optimal trajectory.
    *
@@ -43,9 +99,55 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
    */
   expected<SwerveSolution, std::string> Generate(bool diagnostics = false);
 
+  /**
+   * Generates a trajectory with the given solver options.
+   *
+   * This function may take a long time to complete.
+   *
+   * @param options The solver options.
+   * @return Returns a holonomic trajectory on success, or a string containing a
+   *   failure reason.
+   */
+  expected<SwerveSolution, std::string> Generate(
+      const GenerationOptions& options);
+
+  /**
+   * Adds a callback to retrieve the state of the solver, like
+   * SwervePathBuilder::AddIntermediateCallback() but for this generator only.
+   * Generators sharing a SwervePathSpec can report to different places this
+   * way.
+   *
+   * @param callback The callback.
+   */
+  void AddIntermediateCallback(
+      std::function<void(SwerveSolution&, int64_t)> callback);
+
+  /**
+   * Returns how many intermediate solutions this generator's generations have
+   * sent to the path's callbacks, and how many a callback thread dropped.
+   */
+  CallbackCounters GetCallbackCounters() const;
+
+  ~SwerveTrajectoryGenerator();
+
  private:
+  friend class DecomposedSwerveTrajectoryGenerator;
+  friend class GenerationPool;
+  friend class RecedingHorizonSwerveTrajectoryGenerator;
+
+  /// Solver for the pieces of a path split at its pinned waypoints, or nullptr
+  /// if this generator solves the whole path itself
+  std::unique_ptr<DecomposedSwerveTrajectoryGenerator> decomposed;
+
+  /// The shared path
+  std::shared_ptr<const SwervePathSpec> spec;
+
   /// Swerve path
-  SwervePath path;
+  const SwervePath& path;
+
+  /// The path's intermediate callbacks, then the ones added to this generator
+  std::vector<std::function<void(SwerveSolution&, int64_t)>>
+      intermediateCallbacks;
 
   /// State Variables
   std::vector<sleipnir::Variable> x;
@@ -55,13 +157,17 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   std::vector<sleipnir::Variable> vx;
   std::vector<sleipnir::Variable> vy;
   std::vector<sleipnir::Variable> omega;
+
+  /// Accelerations, which are expressions of the module forces in the reduced
+  /// transcription
   std::vector<sleipnir::Variable> ax;
   std::vector<sleipnir::Variable> ay;
   std::vector<sleipnir::Variable> alpha;
 
-  /// Input Variables
-  std::vector<std::vector<sleipnir::Variable>> Fx;
-  std::vector<std::vector<sleipnir::Variable>> Fy;
+  /// Input Variables, with every module's force at a sample stored together
+  /// (see ForceIndex())
+  std::vector<sleipnir::Variable> Fx;
+  std::vector<sleipnir::Variable> Fy;
 
   /// Time Variables
   std::vector<sleipnir::Variable> dt;
@@ -69,12 +175,66 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   /// Discretization Constants
   std::vector<size_t> N;
 
+  /// Identifier for state callbacks
+  int64_t handle;
+
   sleipnir::OptimizationProblem problem;
+
+  /// The path's objective, which a feasibility-only solve replaces for the
+  /// duration of the solve
+  sleipnir::Variable objective;
+
   std::vector<std::function<void()>> callbacks;
 
+  /// Delivers the path's callbacks during a solve if they're called on a
+  /// thread of their own
+  std::unique_ptr<detail::CallbackReporter> reporter;
+
+  CallbackCounters callbackCounters;
+
+  SwerveTrajectoryGenerator(std::shared_ptr<const SwervePathSpec> spec,
+                            const SwerveSolution& initialGuess, int64_t handle,
+                            bool splitAtPinnedWaypoints);
+
+  /// Returns the index in Fx and Fy of a module's force at a sample.
+  size_t ForceIndex(size_t sampleIndex, size_t moduleIndex) const {
+    return sampleIndex * path.drivetrain.modules.size() + moduleIndex;
+  }
+
+  /// Applies the dynamics and module limits at every sample. In the reduced
+  /// transcription, the dynamics define the accelerations instead. ModuleCount
+  /// is the drivetrain's module count if it's known at compile time, so the
+  /// loops over modules can be unrolled, or std::dynamic_extent otherwise.
+  template <size_t ModuleCount>
+  void ApplyDynamics();
+
   void ApplyInitialGuess(const SwerveSolution& solution);
 
+  /// Solves the problem, stopping if the cancellation counter differs from
+  /// cancellationGeneration, its value when the generation started.
+  expected<SwerveSolution, std::string> Solve(const GenerationOptions& options,
+                                              int cancellationGeneration);
+
   SwerveSolution ConstructSwerveSolution();
+
+  /// Overwrites the solution with the current iterate, reusing its storage.
+  void ConstructSwerveSolution(SwerveSolution& solution);
+
+  /// Returns the total time expression.
+  sleipnir::Variable TotalTime();
+
+  /// Returns the expression of the path's objective.
+  sleipnir::Variable BuildObjective();
+
+  /// Returns the value of the objective a solve with the given mode minimizes,
+  /// the path's objective or zero, for a solution with one dt per control
+  /// interval. It mirrors BuildObjective().
+  double ObjectiveValue(const SwerveSolution& solution,
+                        GenerationMode mode) const;
+
+  /// Returns the largest violation of any of the problem's constraints by a
+  /// solution with one dt per control interval.
+  double MaxViolation(const SwerveSolution& solution) const;
 };
 
 }  // namespace trajopt
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <sleipnir/autodiff/Variable.hpp>
 #include <sleipnir/optimization/OptimizationProblem.hpp>
@@ -29,6 +31,11 @@ class TRAJOPT_DLLEXPORT AngularVelocityMaxMagnitudeConstraint {
     assert(maxMagnitude >= 0.0);
   }
 
+  /**
+   * Returns the maximum angular velocity magnitude.
+   */
+  double MaxMagnitude() const { return m_maxMagnitude; }
+
   /**
    * Applies this constraint to the given problem.
    *
@@ -39,12 +46,13 @@ class TRAJOPT_DLLEXPORT AngularVelocityMaxMagnitudeConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem,
-             [[maybe_unused]] const Pose2v& pose,
-             [[maybe_unused]] const Translation2v& linearVelocity,
-             const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
+  void Apply(
+      sleipnir::OptimizationProblem& problem,
+      [[maybe_unused]] const Pose2v& pose,
+      [[maybe_unused]] const Translation2v& linearVelocity,
+      const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
     if (m_maxMagnitude == 0.0) {
       problem.SubjectTo(angularVelocity == 0.0);
     } else {
@@ -53,6 +61,25 @@ class TRAJOPT_DLLEXPORT AngularVelocityMaxMagnitudeConstraint {
     }
   }
 
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the angular velocity magnitude exceeds the
+   *     maximum (rad/s), or zero if the constraint is satisfied.
+   */
+  double Evaluate([[maybe_unused]] const Pose2d& pose,
+                  [[maybe_unused]] const Translation2d& linearVelocity,
+                  double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::max(0.0, std::abs(angularVelocity) - m_maxMagnitude);
+  }
+
  private:
   double m_maxMagnitude;
 };
@@ -33,18 +33,31 @@ namespace trajopt {
  * 1. Include the type's header file
  * 2. Add a constraint static assert for the type
  * 3. Add the type to Constraint's std::variant type list
+ *
+ * Apply() adds the constraint to an optimization problem. Evaluate() computes
+ * the constraint violation at a robot state on plain doubles, which is zero if
+ * the constraint is satisfied, so callers can screen constraints without
+ * building autodiff expressions.
  */
 template <typename T>
 concept ConstraintType =
-    requires(T self, sleipnir::OptimizationProblem& problem, const Pose2v& pose,
-             const Translation2v& linearVelocity,
+    requires(T self, const T constSelf, sleipnir::OptimizationProblem& problem,
+             const Pose2v& pose, const Translation2v& linearVelocity,
              const sleipnir::Variable& angularVelocity,
              const Translation2v& linearAcceleration,
-             const sleipnir::Variable& angularAcceleration) {
+             const sleipnir::Variable& angularAcceleration,
+             const Pose2d& poseValue, const Translation2d& linearVelocityValue,
+             double angularVelocityValue,
+             const Translation2d& linearAccelerationValue,
+             double angularAccelerationValue) {
       {
         self.Apply(problem, pose, linearVelocity, angularVelocity,
                    linearAcceleration, angularAcceleration)
       } -> std::same_as<void>;
+      {
+        constSelf.Evaluate(poseValue, linearVelocityValue, angularVelocityValue,
+                           linearAccelerationValue, angularAccelerationValue)
+      } -> std::same_as<double>;
     };
 
 static_assert(ConstraintType<AngularVelocityMaxMagnitudeConstraint>);
@@ -66,4 +79,29 @@ using Constraint =
                  PointLineConstraint, PointPointConstraint,
                  PoseEqualityConstraint, TranslationEqualityConstraint>;
 
+/**
+ * Evaluates a constraint at the given robot state.
+ *
+ * @param constraint The constraint.
+ * @param pose The robot's pose.
+ * @param linearVelocity The robot's linear velocity.
+ * @param angularVelocity The robot's angular velocity.
+ * @param linearAcceleration The robot's linear acceleration.
+ * @param angularAcceleration The robot's angular acceleration.
+ * @return The constraint violation, which is zero if the constraint is
+ *     satisfied.
+ */
+inline double Evaluate(const Constraint& constraint, const Pose2d& pose,
+                       const Translation2d& linearVelocity,
+                       double angularVelocity,
+                       const Translation2d& linearAcceleration,
+                       double angularAcceleration) {
+  return std::visit(
+      [&](auto&& arg) {
+        return arg.Evaluate(pose, linearVelocity, angularVelocity,
+                            linearAcceleration, angularAcceleration);
+      },
+      constraint);
+}
+
 }  // namespace trajopt
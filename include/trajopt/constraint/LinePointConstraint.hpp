@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/Variable.hpp>
 #include <sleipnir/optimization/OptimizationProblem.hpp>
 
+#include "trajopt/constraint/detail/FieldGeometryCache.hpp"
 #include "trajopt/constraint/detail/LinePointDistance.hpp"
 #include "trajopt/geometry/Pose2.hpp"
 #include "trajopt/geometry/Translation2.hpp"
@@ -52,20 +55,74 @@ class TRAJOPT_DLLEXPORT LinePointConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem, const Pose2v& pose,
-             [[maybe_unused]] const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
-    auto lineStart =
-        pose.Translation() + m_robotLineStart.RotateBy(pose.Rotation());
-    auto lineEnd =
-        pose.Translation() + m_robotLineEnd.RotateBy(pose.Rotation());
-    auto dist = detail::LinePointDistance(lineStart, lineEnd, m_fieldPoint);
-    problem.SubjectTo(dist * dist >= m_minDistance * m_minDistance);
+  void Apply(
+      sleipnir::OptimizationProblem& problem, const Pose2v& pose,
+      [[maybe_unused]] const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
+    problem.SubjectTo(SquaredDistance(pose) >= m_minDistance * m_minDistance);
+  }
+
+  /**
+   * Applies this constraint to the given problem, looking up bumper geometry
+   * in the field frame from a cache shared with other constraints at the same
+   * sample.
+   *
+   * @param problem The optimization problem.
+   * @param fieldGeometry The bumper geometry in the field frame at the sample.
+   */
+  void Apply(sleipnir::OptimizationProblem& problem,
+             detail::FieldGeometryCache& fieldGeometry) const {
+    auto line = fieldGeometry.Line(m_robotLineStart, m_robotLineEnd);
+    problem.SubjectTo(detail::LinePointSquaredDistance(line, m_fieldPoint) >=
+                      m_minDistance * m_minDistance);
+  }
+
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the robot line is closer to the field point
+   *     than the minimum distance (meters), or zero if the constraint is
+   *     satisfied.
+   */
+  double Evaluate(const Pose2d& pose,
+                  [[maybe_unused]] const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::max(0.0, m_minDistance - std::sqrt(SquaredDistance(pose)));
   }
 
  private:
+  /**
+   * Returns the squared distance between the robot line and the field point.
+   *
+   * @param pose The robot's pose.
+   */
+  template <typename T>
+  T SquaredDistance(const Pose2<T>& pose) const {
+    return SquaredDistance(detail::ToFieldFrame(pose, m_robotLineStart),
+                           detail::ToFieldFrame(pose, m_robotLineEnd));
+  }
+
+  /**
+   * Returns the squared distance between the robot line and the field point.
+   *
+   * @param lineStart The robot line's start in the field frame.
+   * @param lineEnd The robot line's end in the field frame.
+   */
+  template <typename T>
+  T SquaredDistance(const Translation2<T>& lineStart,
+                    const Translation2<T>& lineEnd) const {
+    return detail::LinePointSquaredDistance(lineStart, lineEnd, m_fieldPoint);
+  }
+
   Translation2d m_robotLineStart;
   Translation2d m_robotLineEnd;
   Translation2d m_fieldPoint;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 
 #include <sleipnir/autodiff/Variable.hpp>
@@ -39,12 +40,13 @@ class TRAJOPT_DLLEXPORT LinearAccelerationMaxMagnitudeConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem,
-             [[maybe_unused]] const Pose2v& pose,
-             [[maybe_unused]] const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
+  void Apply(
+      sleipnir::OptimizationProblem& problem,
+      [[maybe_unused]] const Pose2v& pose,
+      [[maybe_unused]] const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
     if (m_maxMagnitude == 0.0) {
       problem.SubjectTo(linearAcceleration.X() == 0.0);
       problem.SubjectTo(linearAcceleration.Y() == 0.0);
@@ -54,6 +56,25 @@ class TRAJOPT_DLLEXPORT LinearAccelerationMaxMagnitudeConstraint {
     }
   }
 
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the linear acceleration magnitude exceeds the
+   *     maximum (m/s²), or zero if the constraint is satisfied.
+   */
+  double Evaluate([[maybe_unused]] const Pose2d& pose,
+                  [[maybe_unused]] const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::max(0.0, linearAcceleration.Norm() - m_maxMagnitude);
+  }
+
  private:
   double m_maxMagnitude;
 };
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include <sleipnir/autodiff/Variable.hpp>
 #include <sleipnir/optimization/OptimizationProblem.hpp>
 
@@ -33,12 +35,12 @@ class TRAJOPT_DLLEXPORT LinearVelocityDirectionConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply([[maybe_unused]] sleipnir::OptimizationProblem& problem,
-             [[maybe_unused]] const Pose2v& pose,
-             const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
+  void Apply(
+      [[maybe_unused]] sleipnir::OptimizationProblem& problem,
+      [[maybe_unused]] const Pose2v& pose, const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
     // <v_x, v_y> and <u_x, u_y> must be parallel
     //
     //   (v ⋅ u)/‖v‖ = 1
@@ -48,6 +50,26 @@ class TRAJOPT_DLLEXPORT LinearVelocityDirectionConstraint {
     problem.SubjectTo(dot * dot == linearVelocity.SquaredNorm());
   }
 
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The magnitude of the linear velocity component perpendicular to
+   *     the desired direction (m/s), or zero if the constraint is satisfied.
+   */
+  double Evaluate([[maybe_unused]] const Pose2d& pose,
+                  const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::abs(
+        linearVelocity.Cross(Translation2d{m_angle.Cos(), m_angle.Sin()}));
+  }
+
  private:
   trajopt::Rotation2d m_angle;
 };
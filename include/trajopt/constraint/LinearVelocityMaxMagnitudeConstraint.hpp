@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 
 #include <sleipnir/autodiff/Variable.hpp>
@@ -29,6 +30,11 @@ class TRAJOPT_DLLEXPORT LinearVelocityMaxMagnitudeConstraint {
     assert(maxMagnitude >= 0.0);
   }
 
+  /**
+   * Returns the maximum linear velocity magnitude.
+   */
+  double MaxMagnitude() const { return m_maxMagnitude; }
+
   /**
    * Applies this constraint to the given problem.
    *
@@ -39,12 +45,12 @@ class TRAJOPT_DLLEXPORT LinearVelocityMaxMagnitudeConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem,
-             [[maybe_unused]] const Pose2v& pose,
-             const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
+  void Apply(
+      sleipnir::OptimizationProblem& problem,
+      [[maybe_unused]] const Pose2v& pose, const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
     if (m_maxMagnitude == 0.0) {
       problem.SubjectTo(linearVelocity.X() == 0.0);
       problem.SubjectTo(linearVelocity.Y() == 0.0);
@@ -54,6 +60,25 @@ class TRAJOPT_DLLEXPORT LinearVelocityMaxMagnitudeConstraint {
     }
   }
 
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the linear velocity magnitude exceeds the
+   *     maximum (m/s), or zero if the constraint is satisfied.
+   */
+  double Evaluate([[maybe_unused]] const Pose2d& pose,
+                  const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::max(0.0, linearVelocity.Norm() - m_maxMagnitude);
+  }
+
  private:
   double m_maxMagnitude;
 };
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/Variable.hpp>
@@ -44,11 +46,12 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem, const Pose2v& pose,
-             [[maybe_unused]] const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
+  void Apply(
+      sleipnir::OptimizationProblem& problem, const Pose2v& pose,
+      [[maybe_unused]] const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
     // dx,dy = desired heading
     // ux,uy = unit vector of desired heading
     // hx,hy = heading
@@ -56,14 +59,52 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
     //
     // constrain dot to cos(1.0), which is colinear
     // and cos(thetaTolerance)
+    auto [dot, dist] = DotAndDistance(pose);
+    problem.SubjectTo(dot >= std::cos(m_headingTolerance) * dist);
+  }
+
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the angle between the robot's heading and the
+   *     field point exceeds the heading tolerance (radians), or zero if the
+   *     constraint is satisfied.
+   */
+  double Evaluate(const Pose2d& pose,
+                  [[maybe_unused]] const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    auto [dot, dist] = DotAndDistance(pose);
+    if (dist == 0.0) {
+      return 0.0;
+    }
+    double angle = std::acos(std::clamp(dot / dist, -1.0, 1.0));
+    return std::max(0.0, angle - m_headingTolerance);
+  }
+
+ private:
+  /**
+   * Returns the dot product of the robot's heading with the vector from the
+   * robot to the field point, and the distance to the field point.
+   *
+   * @param pose The robot's pose.
+   */
+  template <typename T>
+  std::pair<T, T> DotAndDistance(const Pose2<T>& pose) const {
+    using std::hypot;
+
     auto dx = m_fieldPoint.X() - pose.X();
     auto dy = m_fieldPoint.Y() - pose.Y();
     auto dot = pose.Rotation().Cos() * dx + pose.Rotation().Sin() * dy;
-    problem.SubjectTo(dot >=
-                      std::cos(m_headingTolerance) * sleipnir::hypot(dx, dy));
+    return {dot, hypot(dx, dy)};
   }
 
- private:
   Translation2d m_fieldPoint;
   double m_headingTolerance;
 };
@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/Variable.hpp>
 #include <sleipnir/optimization/OptimizationProblem.hpp>
 
+#include "trajopt/constraint/detail/FieldGeometryCache.hpp"
 #include "trajopt/constraint/detail/LinePointDistance.hpp"
 #include "trajopt/geometry/Pose2.hpp"
 #include "trajopt/geometry/Translation2.hpp"
@@ -36,8 +39,7 @@ class TRAJOPT_DLLEXPORT PointLineConstraint {
                                Translation2d fieldLineStart,
                                Translation2d fieldLineEnd, double minDistance)
       : m_robotPoint{std::move(robotPoint)},
-        m_fieldLineStart{std::move(fieldLineStart)},
-        m_fieldLineEnd{std::move(fieldLineEnd)},
+        m_fieldLine{std::move(fieldLineStart), std::move(fieldLineEnd)},
         m_minDistance{minDistance} {
     assert(minDistance >= 0.0);
   }
@@ -52,21 +54,72 @@ class TRAJOPT_DLLEXPORT PointLineConstraint {
    * @param linearAcceleration The robot's linear acceleration.
    * @param angularAcceleration The robot's angular acceleration.
    */
-  void Apply(sleipnir::OptimizationProblem& problem, const Pose2v& pose,
-             [[maybe_unused]] const Translation2v& linearVelocity,
-             [[maybe_unused]] const sleipnir::Variable& angularVelocity,
-             [[maybe_unused]] const Translation2v& linearAcceleration,
-             [[maybe_unused]] const sleipnir::Variable& angularAcceleration) {
-    auto point = pose.Translation() + m_robotPoint.RotateBy(pose.Rotation());
-    auto dist =
-        detail::LinePointDistance(m_fieldLineStart, m_fieldLineEnd, point);
-    problem.SubjectTo(dist * dist >= m_minDistance * m_minDistance);
+  void Apply(
+      sleipnir::OptimizationProblem& problem, const Pose2v& pose,
+      [[maybe_unused]] const Translation2v& linearVelocity,
+      [[maybe_unused]] const sleipnir::Variable& angularVelocity,
+      [[maybe_unused]] const Translation2v& linearAcceleration,
+      [[maybe_unused]] const sleipnir::Variable& angularAcceleration) const {
+    problem.SubjectTo(SquaredDistance(pose) >= m_minDistance * m_minDistance);
+  }
+
+  /**
+   * Applies this constraint to the given problem, looking up bumper geometry
+   * in the field frame from a cache shared with other constraints at the same
+   * sample.
+   *
+   * @param problem The optimization problem.
+   * @param fieldGeometry The bumper geometry in the field frame at the sample.
+   */
+  void Apply(sleipnir::OptimizationProblem& problem,
+             detail::FieldGeometryCache& fieldGeometry) const {
+    problem.SubjectTo(SquaredDistance(fieldGeometry.Point(m_robotPoint)) >=
+                      m_minDistance * m_minDistance);
+  }
+
+  /**
+   * Evaluates this constraint at the given robot state.
+   *
+   * @param pose The robot's pose.
+   * @param linearVelocity The robot's linear velocity.
+   * @param angularVelocity The robot's angular velocity.
+   * @param linearAcceleration The robot's linear acceleration.
+   * @param angularAcceleration The robot's angular acceleration.
+   * @return The amount by which the robot point is closer to the field line
+   *     than the minimum distance (meters), or zero if the constraint is
+   *     satisfied.
+   */
+  double Evaluate(const Pose2d& pose,
+                  [[maybe_unused]] const Translation2d& linearVelocity,
+                  [[maybe_unused]] double angularVelocity,
+                  [[maybe_unused]] const Translation2d& linearAcceleration,
+                  [[maybe_unused]] double angularAcceleration) const {
+    return std::max(0.0, m_minDistance - std::sqrt(SquaredDistance(pose)));
   }
 
  private:
+  /**
+   * Returns the squared distance between the robot point and the field line.
+   *
+   * @param pose The robot's pose.
+   */
+  template <typename T>
+  T SquaredDistance(const Pose2<T>& pose) const {
+    return SquaredDistance(detail::ToFieldFrame(pose, m_robotPoint));
+  }
+
+  /**
+   * Returns the squared distance between the robot point and the field line.
+   *
+   * @param point The robot point in the field frame.
+   */
+  template <typename T>
+  T SquaredDistance(const Translation2<T>& point) const {
+    return detail::LinePointSquaredDistance(m_fieldLine, point);
+  }
+
   Translation2d m_robotPoint;
-  Translation2d m_fieldLineStart;
-  Translation2d m_fieldLineEnd;
+  detail::LineSegment<double> m_fieldLine;
   double m_minDistance;
 };
 
@@ -0,0 +1,106 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/Variable.hpp>
+
+#include "trajopt/constraint/detail/LinePointDistance.hpp"
+#include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+
+namespace trajopt::detail {
+
+/**
+ * Returns a point in the robot frame transformed into the field frame.
+ *
+ * @param pose The robot's pose.
+ * @param robotPoint The point in the robot frame.
+ */
+template <typename T>
+Translation2<T> ToFieldFrame(const Pose2<T>& pose,
+                             const Translation2d& robotPoint) {
+  return pose.Translation() + robotPoint.RotateBy(pose.Rotation());
+}
+
+/**
+ * Caches robot-frame bumper geometry transformed into the field frame at one
+ * sample.
+ *
+ * Obstacle constraints reference the same few bumper corners and edges for
+ * every obstacle. Looking them up here instead of transforming them in every
+ * constraint makes all of those constraints share one autodiff expression per
+ * corner and per edge, which shrinks the expression graph the solver
+ * differentiates.
+ */
+class FieldGeometryCache {
+ public:
+  /**
+   * Constructs a FieldGeometryCache.
+   *
+   * @param pose The robot's pose at the sample.
+   */
+  explicit FieldGeometryCache(Pose2v pose) : m_pose{std::move(pose)} {}
+
+  /**
+   * Returns the robot's pose at the sample.
+   */
+  const Pose2v& Pose() const { return m_pose; }
+
+  /**
+   * Returns a point in the robot frame transformed into the field frame.
+   *
+   * @param robotPoint The point in the robot frame.
+   */
+  Translation2v Point(const Translation2d& robotPoint) {
+    // Robots have few distinct bumper corners, so a linear search is faster
+    // than hashing
+    for (const auto& [key, fieldPoint] : m_points) {
+      if (Equals(key, robotPoint)) {
+        return fieldPoint;
+      }
+    }
+    return m_points.emplace_back(robotPoint, ToFieldFrame(m_pose, robotPoint))
+        .second;
+  }
+
+  /**
+   * Returns a line segment in the robot frame transformed into the field
+   * frame.
+   *
+   * @param robotLineStart The line segment's start in the robot frame.
+   * @param robotLineEnd The line segment's end in the robot frame.
+   */
+  LineSegment<sleipnir::Variable> Line(const Translation2d& robotLineStart,
+                                       const Translation2d& robotLineEnd) {
+    for (const auto& [start, end, line] : m_lines) {
+      if (Equals(start, robotLineStart) && Equals(end, robotLineEnd)) {
+        return line;
+      }
+    }
+    m_lines.push_back(CachedLine{
+        robotLineStart, robotLineEnd,
+        LineSegment<sleipnir::Variable>{Point(robotLineStart),
+                                        Point(robotLineEnd)}});
+    return m_lines.back().line;
+  }
+
+ private:
+  struct CachedLine {
+    Translation2d start;
+    Translation2d end;
+    LineSegment<sleipnir::Variable> line;
+  };
+
+  Pose2v m_pose;
+  std::vector<std::pair<Translation2d, Translation2v>> m_points;
+  std::vector<CachedLine> m_lines;
+
+  static bool Equals(const Translation2d& lhs, const Translation2d& rhs) {
+    return lhs.X() == rhs.X() && lhs.Y() == rhs.Y();
+  }
+};
+
+}  // namespace trajopt::detail
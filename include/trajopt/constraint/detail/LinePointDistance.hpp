@@ -2,36 +2,98 @@
 
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <utility>
+
 #include <sleipnir/autodiff/Variable.hpp>
 
 #include "trajopt/geometry/Translation2.hpp"
 
 namespace trajopt::detail {
 
-// https://www.desmos.com/calculator/cqmc1tjtsv
+/**
+ * A line segment along with the quantities the line-point distance needs.
+ */
+template <typename T>
+struct LineSegment {
+  /**
+   * Constructs a LineSegment.
+   *
+   * @param start The line segment's start.
+   * @param end The line segment's end.
+   */
+  LineSegment(Translation2<T> start, Translation2<T> end)
+      : start{std::move(start)},
+        direction{end - this->start},
+        squaredLength{direction.SquaredNorm()} {}
+
+  /// The line segment's start.
+  Translation2<T> start;
+
+  /// The vector from the line segment's start to its end.
+  Translation2<T> direction;
+
+  /// The squared length of the line segment.
+  T squaredLength;
+};
+
+/**
+ * Returns the squared distance between a line segment and a point.
+ *
+ * This works on both autodiff variables and doubles so the solver and the
+ * trajectory validator share the same geometry.
+ *
+ * https://www.desmos.com/calculator/cqmc1tjtsv
+ *
+ * @param line The line segment.
+ * @param point The point.
+ * @return The squared distance between the line segment and the point.
+ */
 template <typename T, typename U>
-decltype(auto) LinePointDistance(const Translation2<T>& lineStart,
-                                 const Translation2<T>& lineEnd,
-                                 const Translation2<U>& point) {
+decltype(auto) LinePointSquaredDistance(const LineSegment<T>& line,
+                                        const Translation2<U>& point) {
   using R = decltype(std::declval<T>() + std::declval<U>());
 
   auto max = [](R a, R b) {
-    return +0.5 * (1 + sleipnir::sign(b - a)) * (b - a) + a;
+    if constexpr (std::same_as<R, double>) {
+      return std::max(a, b);
+    } else {
+      return +0.5 * (1 + sleipnir::sign(b - a)) * (b - a) + a;
+    }
   };
   auto min = [](R a, R b) {
-    return -0.5 * (1 + sleipnir::sign(b - a)) * (b - a) + b;
+    if constexpr (std::same_as<R, double>) {
+      return std::min(a, b);
+    } else {
+      return -0.5 * (1 + sleipnir::sign(b - a)) * (b - a) + b;
+    }
   };
-  auto Lerp = [](R a, R b, R t) { return a + t * (b - a); };
 
-  Translation2<R> l{lineEnd.X() - lineStart.X(), lineEnd.Y() - lineStart.Y()};
-  Translation2<R> v{point.X() - lineStart.X(), point.Y() - lineStart.Y()};
+  const auto& l = line.direction;
+  Translation2<R> v{point.X() - line.start.X(), point.Y() - line.start.Y()};
 
-  auto t = v.Dot(l) / l.SquaredNorm();
+  auto t = v.Dot(l) / line.squaredLength;
   auto tBounded = max(min(t, 1), 0);  // NOLINT
 
-  Translation2<R> i{Lerp(lineStart.X(), lineEnd.X(), tBounded),
-                    Lerp(lineStart.Y(), lineEnd.Y(), tBounded)};
+  Translation2<R> i{line.start.X() + tBounded * l.X(),
+                    line.start.Y() + tBounded * l.Y()};
   return (i - point).SquaredNorm();
 }
 
+/**
+ * Returns the squared distance between a line segment and a point.
+ *
+ * @param lineStart The line segment's start.
+ * @param lineEnd The line segment's end.
+ * @param point The point.
+ * @return The squared distance between the line segment and the point.
+ */
+template <typename T, typename U>
+decltype(auto) LinePointSquaredDistance(const Translation2<T>& lineStart,
+                                        const Translation2<T>& lineEnd,
+                                        const Translation2<U>& point) {
+  return LinePointSquaredDistance(LineSegment<T>{lineStart, lineEnd}, point);
+}
+
 }  // namespace trajopt::detail
@@ -0,0 +1,91 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "trajopt/drivetrain/SwerveDrivetrain.hpp"
+#include "trajopt/drivetrain/SwerveModule.hpp"
+#include "trajopt/geometry/Rotation2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+
+namespace trajopt::detail {
+
+/**
+ * Returns the velocity of a swerve module's wheel in the robot frame.
+ *
+ * @param module The swerve module.
+ * @param robotVelocity The robot's linear velocity in the robot frame.
+ * @param angularVelocity The robot's angular velocity.
+ * @return The wheel's velocity in the robot frame.
+ */
+template <typename T>
+Translation2<T> ModuleVelocity(const SwerveModule& module,
+                               const Translation2<T>& robotVelocity,
+                               const T& angularVelocity) {
+  return Translation2<T>{
+      robotVelocity.X() - module.translation.Y() * angularVelocity,
+      robotVelocity.Y() + module.translation.X() * angularVelocity};
+}
+
+/**
+ * Returns the torque a swerve module's force exerts about the robot's origin.
+ *
+ * @param module The swerve module.
+ * @param heading The robot's heading.
+ * @param force The module's force in the field frame.
+ * @return The torque about the robot's origin.
+ */
+template <typename T>
+T ModuleTorque(const SwerveModule& module, const Rotation2<T>& heading,
+               const Translation2<T>& force) {
+  auto r = module.translation.RotateBy(heading);
+  return r.Cross(force);
+}
+
+/**
+ * Returns the maximum speed of a swerve module's wheel.
+ *
+ * @param module The swerve module.
+ */
+constexpr double ModuleMaxVelocity(const SwerveModule& module) {
+  return module.wheelRadius * module.wheelMaxAngularVelocity;
+}
+
+/**
+ * Returns the maximum force a swerve module's wheel can exert on the ground.
+ *
+ * @param module The swerve module.
+ */
+constexpr double ModuleMaxForce(const SwerveModule& module) {
+  return module.wheelMaxTorque / module.wheelRadius;
+}
+
+/**
+ * Returns the smallest nonzero distance along either axis between consecutive
+ * modules, or infinity if there's none. No wheel may travel farther than this
+ * in one time step.
+ *
+ * @param drivetrain The drivetrain.
+ */
+inline double MinModuleSpacing(const SwerveDrivetrain& drivetrain) {
+  const auto& modules = drivetrain.modules;
+  double minWidth = INFINITY;
+  for (size_t i = 1; i < modules.size(); i++) {
+    double width = std::abs(modules[i - 1].translation.X() -
+                            modules[i].translation.X());
+    if (width != 0) {
+      minWidth = std::min(minWidth, width);
+    }
+    double height = std::abs(modules[i - 1].translation.Y() -
+                             modules[i].translation.Y());
+    if (height != 0) {
+      minWidth = std::min(minWidth, height);
+    }
+  }
+  return minWidth;
+}
+
+}  // namespace trajopt::detail
@@ -0,0 +1,86 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <span>
+#include <string_view>
+
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+// Geometry kernels over whole arrays of doubles, such as the columns of a
+// SwerveSolution. They compute what Translation2d, Rotation2d, and the
+// line-point distance compute for one element, several elements at a time
+// with SIMD instructions when the library is built for AVX2 or NEON, and one
+// at a time otherwise.
+//
+// Every span passed to a kernel must have the same size. Outputs may be the
+// same arrays as inputs.
+
+/**
+ * Returns the instruction set the batch geometry kernels use: "AVX2", "NEON",
+ * or "scalar".
+ */
+TRAJOPT_DLLEXPORT std::string_view BatchInstructionSet();
+
+/**
+ * Rotates each point by the rotation at the same index, like
+ * Translation2d::RotateBy().
+ *
+ * @param x The points' x components.
+ * @param y The points' y components.
+ * @param cos The rotations' cosines.
+ * @param sin The rotations' sines.
+ * @param rotatedX Receives the rotated points' x components.
+ * @param rotatedY Receives the rotated points' y components.
+ */
+TRAJOPT_DLLEXPORT void BatchRotateBy(std::span<const double> x,
+                                     std::span<const double> y,
+                                     std::span<const double> cos,
+                                     std::span<const double> sin,
+                                     std::span<double> rotatedX,
+                                     std::span<double> rotatedY);
+
+/**
+ * Computes the squared distance between a line segment and each point.
+ *
+ * @param lineStart The line segment's start.
+ * @param lineEnd The line segment's end. It must differ from the start.
+ * @param x The points' x components.
+ * @param y The points' y components.
+ * @param squaredDistances Receives the squared distances.
+ */
+TRAJOPT_DLLEXPORT void BatchLinePointSquaredDistance(
+    const Translation2d& lineStart, const Translation2d& lineEnd,
+    std::span<const double> x, std::span<const double> y,
+    std::span<double> squaredDistances);
+
+/**
+ * Converts headings from cosines and sines to radians in [-π, π], like
+ * Rotation2d::Radians().
+ *
+ * @param cos The headings' cosines.
+ * @param sin The headings' sines.
+ * @param radians Receives the headings in radians.
+ */
+TRAJOPT_DLLEXPORT void BatchRadians(std::span<const double> cos,
+                                    std::span<const double> sin,
+                                    std::span<double> radians);
+
+/**
+ * Converts headings from radians to cosines and sines.
+ *
+ * The results are accurate to a few ulp for headings under 2³⁰ radians in
+ * magnitude.
+ *
+ * @param radians The headings in radians.
+ * @param cos Receives the headings' cosines.
+ * @param sin Receives the headings' sines.
+ */
+TRAJOPT_DLLEXPORT void BatchCosSin(std::span<const double> radians,
+                                   std::span<double> cos,
+                                   std::span<double> sin);
+
+}  // namespace trajopt
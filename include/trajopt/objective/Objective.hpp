@@ -0,0 +1,47 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <variant>
+
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * Minimizes the path's total time.
+ */
+struct TRAJOPT_DLLEXPORT MinimumTimeObjective {};
+
+/**
+ * Minimizes the sum over every sample of each module's squared force as a
+ * fraction of its maximum force.
+ *
+ * Without a total time constraint, the robot would drive as slowly as the
+ * problem allows, so this is meant to be paired with
+ * SwervePathBuilder::TotalTime() or SwervePathBuilder::MaxTotalTime() to
+ * arrive at a given time with as little effort as possible.
+ */
+struct TRAJOPT_DLLEXPORT MinimumForceObjective {};
+
+/**
+ * Minimizes the path's total time plus a penalty on how much the robot's
+ * acceleration changes between samples.
+ *
+ * The penalty stands in for jerk without dividing by the sample period, which
+ * would make the problem harder to solve. It gives gentler trajectories that
+ * are slightly slower than minimum-time ones.
+ */
+struct TRAJOPT_DLLEXPORT TimeAndJerkObjective {
+  /// Weight of the squared acceleration changes (s⁵/m² for linear and s⁵ for
+  /// angular acceleration) relative to the total time.
+  double jerkWeight = 1e-3;
+};
+
+/**
+ * A path's objective.
+ */
+using Objective = std::variant<MinimumTimeObjective, MinimumForceObjective,
+                               TimeAndJerkObjective>;
+
+}  // namespace trajopt
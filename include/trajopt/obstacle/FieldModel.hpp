@@ -0,0 +1,96 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "trajopt/constraint/Constraint.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/obstacle/Bumpers.hpp"
+#include "trajopt/obstacle/Obstacle.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * The obstacles of a field, built once and shared by every path on it.
+ *
+ * Paths reference a FieldModel through SwervePathBuilder::SetField() instead of
+ * declaring each obstacle with SgmtObstacle(), and the obstacle constraints are
+ * only generated when a generator builds its problem. A uniform grid over the
+ * obstacles' bounds finds those near a segment, so far away ones can be left
+ * out.
+ *
+ * A FieldModel is immutable, so it can be shared between threads.
+ */
+class TRAJOPT_DLLEXPORT FieldModel {
+ public:
+  /**
+   * An axis-aligned box.
+   */
+  struct Bounds {
+    /// The corner with the smallest coordinates.
+    Translation2d min;
+
+    /// The corner with the largest coordinates.
+    Translation2d max;
+  };
+
+  /**
+   * Constructs a FieldModel.
+   *
+   * @param obstacles The obstacles. Obstacles without points are kept but are
+   *   never near anything.
+   * @param cellSize The side length (m) of the spatial index's cells. It must
+   *   be positive.
+   */
+  explicit FieldModel(std::vector<Obstacle> obstacles, double cellSize = 1.0);
+
+  /**
+   * Returns the obstacles.
+   */
+  const std::vector<Obstacle>& GetObstacles() const { return m_obstacles; }
+
+  /**
+   * Returns the bounds of an obstacle, grown by its safety distance.
+   *
+   * @param obstacleIndex The obstacle's index.
+   */
+  const Bounds& GetBounds(size_t obstacleIndex) const {
+    return m_bounds[obstacleIndex];
+  }
+
+  /**
+   * Returns the indices of the obstacles whose bounds overlap a box, in
+   * ascending order.
+   *
+   * @param bounds The box.
+   */
+  std::vector<size_t> ObstaclesNear(const Bounds& bounds) const;
+
+  /**
+   * Appends the constraints that keep the bumpers away from an obstacle.
+   *
+   * @param bumpers The bumpers.
+   * @param obstacleIndex The obstacle's index.
+   * @param constraints The constraints to append to.
+   */
+  void AppendConstraints(const Bumpers& bumpers, size_t obstacleIndex,
+                         std::vector<Constraint>& constraints) const;
+
+ private:
+  std::vector<Obstacle> m_obstacles;
+  std::vector<Bounds> m_bounds;
+
+  /// The grid's cells cover every obstacle's bounds, starting at the origin.
+  Translation2d m_gridOrigin;
+  double m_cellSize;
+  size_t m_columnCount = 0;
+  size_t m_rowCount = 0;
+
+  /// The indices of the obstacles overlapping each cell, row by row.
+  std::vector<std::vector<size_t>> m_cells;
+};
+
+}  // namespace trajopt
@@ -0,0 +1,140 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "trajopt/constraint/Constraint.hpp"
+#include "trajopt/constraint/LinePointConstraint.hpp"
+#include "trajopt/constraint/PointLineConstraint.hpp"
+#include "trajopt/constraint/PointPointConstraint.hpp"
+#include "trajopt/obstacle/Bumpers.hpp"
+#include "trajopt/obstacle/FieldModel.hpp"
+#include "trajopt/obstacle/Obstacle.hpp"
+
+namespace trajopt::detail {
+
+/**
+ * Returns how far any of the bumpers reach from the robot's center, including
+ * their safety distance.
+ *
+ * @param bumpers The bumpers.
+ */
+inline double BumpersReach(const std::vector<Bumpers>& bumpers) {
+  double reach = 0.0;
+  for (const auto& _bumpers : bumpers) {
+    for (const auto& point : _bumpers.points) {
+      reach = std::max(reach, point.Norm() + _bumpers.safetyDistance);
+    }
+  }
+  return reach;
+}
+
+/**
+ * Appends the constraints that keep the bumpers away from the obstacle.
+ *
+ * Every bumper edge keeps its distance from every obstacle corner, and every
+ * obstacle edge from every bumper corner. Polygons with at least three corners
+ * are closed by an edge from their last corner back to their first.
+ *
+ * @param bumpers The bumpers.
+ * @param obstacle The obstacle.
+ * @param constraints The constraints to append to.
+ */
+inline void AppendObstacleConstraints(const Bumpers& bumpers,
+                                      const Obstacle& obstacle,
+                                      std::vector<Constraint>& constraints) {
+  auto minDistance = bumpers.safetyDistance + obstacle.safetyDistance;
+
+  size_t bumperCornerCount = bumpers.points.size();
+  size_t obstacleCornerCount = obstacle.points.size();
+  if (bumperCornerCount == 1 && obstacleCornerCount == 1) {
+    // if the bumpers and obstacle are only one point
+    constraints.emplace_back(PointPointConstraint{
+        bumpers.points.at(0), obstacle.points.at(0), minDistance});
+    return;
+  }
+
+  // robot bumper edge to obstacle point constraints
+  for (auto& obstaclePoint : obstacle.points) {
+    // First apply constraint for all but last edge
+    for (size_t bumperCornerIndex = 0;
+         bumperCornerIndex < bumperCornerCount - 1; bumperCornerIndex++) {
+      constraints.emplace_back(LinePointConstraint{
+          bumpers.points.at(bumperCornerIndex),
+          bumpers.points.at(bumperCornerIndex + 1), obstaclePoint,
+          minDistance});
+    }
+    // apply to last edge: the edge connecting the last point to the first
+    // must have at least three points to need this
+    if (bumperCornerCount >= 3) {
+      constraints.emplace_back(LinePointConstraint{
+          bumpers.points.at(bumperCornerCount - 1), bumpers.points.at(0),
+          obstaclePoint, minDistance});
+    }
+  }
+
+  // obstacle edge to bumper corner constraints
+  for (auto& bumperCorner : bumpers.points) {
+    if (obstacleCornerCount > 1) {
+      for (size_t obstacleCornerIndex = 0;
+           obstacleCornerIndex < obstacleCornerCount - 1;
+           obstacleCornerIndex++) {
+        constraints.emplace_back(PointLineConstraint{
+            bumperCorner, obstacle.points.at(obstacleCornerIndex),
+            obstacle.points.at(obstacleCornerIndex + 1), minDistance});
+      }
+      if (obstacleCornerCount >= 3) {
+        constraints.emplace_back(PointLineConstraint{
+            bumperCorner, obstacle.points.at(obstacleCornerCount - 1),
+            obstacle.points.at(0), minDistance});
+      }
+    } else {
+      constraints.emplace_back(PointPointConstraint{
+          bumperCorner, obstacle.points.at(0), minDistance});
+    }
+  }
+}
+
+/**
+ * Appends the constraints that keep the bumpers away from the field's obstacles
+ * that come within the cull distance of the bumpers anywhere along a segment.
+ *
+ * @param field The field.
+ * @param bumpers The bumpers.
+ * @param cullDistance How far from the bumpers obstacles are kept.
+ * @param x The x coordinates of the segment's samples.
+ * @param y The y coordinates of the segment's samples.
+ * @param constraints The constraints to append to.
+ */
+inline void AppendFieldConstraints(const FieldModel& field,
+                                   const std::vector<Bumpers>& bumpers,
+                                   double cullDistance,
+                                   std::span<const double> x,
+                                   std::span<const double> y,
+                                   std::vector<Constraint>& constraints) {
+  double margin = cullDistance + BumpersReach(bumpers);
+  double minX = INFINITY;
+  double minY = INFINITY;
+  double maxX = -INFINITY;
+  double maxY = -INFINITY;
+  for (size_t index = 0; index < x.size(); ++index) {
+    minX = std::min(minX, x[index]);
+    minY = std::min(minY, y[index]);
+    maxX = std::max(maxX, x[index]);
+    maxY = std::max(maxY, y[index]);
+  }
+
+  for (size_t obstacleIndex : field.ObstaclesNear(
+           {{minX - margin, minY - margin}, {maxX + margin, maxY + margin}})) {
+    for (auto& _bumpers : bumpers) {
+      field.AppendConstraints(_bumpers, obstacleIndex, constraints);
+    }
+  }
+}
+
+}  // namespace trajopt::detail
@@ -5,11 +5,16 @@
 #include <stdint.h>
 
 #include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "trajopt/constraint/Constraint.hpp"
 #include "trajopt/drivetrain/DifferentialDrivetrain.hpp"
 #include "trajopt/drivetrain/SwerveDrivetrain.hpp"
+#include "trajopt/objective/Objective.hpp"
+#include "trajopt/obstacle/Bumpers.hpp"
+#include "trajopt/obstacle/FieldModel.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
 #include "trajopt/util/SymbolExports.hpp"
 
@@ -24,6 +29,25 @@ struct TRAJOPT_DLLEXPORT Waypoint {
 
   /// Continuous constraints along the segment.
   std::vector<Constraint> segmentConstraints;
+
+  /// If set, the segment avoids the path's field obstacles that come within
+  /// this distance (m) of its initial guess.
+  std::optional<double> fieldCullDistance;
+};
+
+/**
+ * How a path's trajectory is transcribed into the solver's problem.
+ */
+enum class Transcription {
+  /// Each sample's accelerations are decision variables, and the dynamics are
+  /// equality constraints between them and the module forces.
+  kFull,
+
+  /// Each sample's accelerations are the net force over the mass and the net
+  /// torque over the moment of inertia, so the problem has three fewer
+  /// variables and equality constraints per sample. The solution has the same
+  /// form either way.
+  kReduced
 };
 
 /**
@@ -36,9 +60,35 @@ struct TRAJOPT_DLLEXPORT SwervePath {
   /// Drivetrain of the robot.
   SwerveDrivetrain drivetrain;
 
+  /// The robot's bumpers, kept away from obstacles.
+  std::vector<Bumpers> bumpers;
+
+  /// The field whose obstacles segments can avoid, shared with other paths.
+  std::shared_ptr<const FieldModel> field;
+
+  /// What the trajectory optimizes.
+  Objective objective;
+
+  /// How the trajectory is transcribed.
+  Transcription transcription = Transcription::kFull;
+
+  /// The path's exact total time (s), if it's fixed.
+  std::optional<double> totalTime;
+
+  /// The largest total time (s) the path may take, if it's limited.
+  std::optional<double> maxTotalTime;
+
   /// A vector of callbacks to be called with the intermediate SwerveSolution
   /// and a user-specified handle at every iteration of the solver.
   std::vector<std::function<void(SwerveSolution&, int64_t)>> callbacks;
+
+  /// The largest number of times per second the callbacks are called. Solver
+  /// iterations in between are skipped.
+  double callbackRate = 60.0;
+
+  /// If true, the callbacks are called on a thread of their own instead of the
+  /// solver's, and updates are dropped while they're busy.
+  bool callbackThread = false;
 };
 
 /**
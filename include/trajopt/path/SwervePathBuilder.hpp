@@ -7,12 +7,16 @@
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include "trajopt/constraint/Constraint.hpp"
 #include "trajopt/drivetrain/SwerveDrivetrain.hpp"
 #include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/objective/Objective.hpp"
 #include "trajopt/obstacle/Bumpers.hpp"
+#include "trajopt/obstacle/FieldModel.hpp"
 #include "trajopt/obstacle/Obstacle.hpp"
 #include "trajopt/path/Path.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
@@ -33,6 +37,13 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
    */
   SwervePath& GetPath();
 
+  /**
+   * Get the SwervePath being constructed
+   *
+   * @return the path
+   */
+  const SwervePath& GetPath() const;
+
   /**
    * Set the Drivetrain object
    *
@@ -40,6 +51,35 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
    */
   void SetDrivetrain(SwerveDrivetrain drivetrain);
 
+  /**
+   * Set what the trajectory optimizes. The default is minimum time.
+   *
+   * @param objective The objective.
+   */
+  void SetObjective(const Objective& objective);
+
+  /**
+   * Set how the trajectory is transcribed into the solver's problem. The
+   * default is the full transcription.
+   *
+   * @param transcription The transcription.
+   */
+  void SetTranscription(Transcription transcription);
+
+  /**
+   * Fix the path's total time.
+   *
+   * @param time The total time (s).
+   */
+  void TotalTime(double time);
+
+  /**
+   * Limit the path's total time.
+   *
+   * @param time The largest total time (s).
+   */
+  void MaxTotalTime(double time);
+
   /**
    * Create a pose waypoint constraint on the waypoint at the provided
    * index, and add an initial guess with the same pose This specifies that the
@@ -77,10 +117,10 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
 
   /**
    * Add a sequence of initial guess points between two waypoints. The points
-   * are inserted between the waypoints at fromIndex and fromIndex + 1. Linear
-   * interpolation between the waypoint initial guess points and these segment
-   * initial guess points is used as the initial guess of the robot's pose over
-   * the trajectory.
+   * are inserted between the waypoints at fromIndex and fromIndex + 1. A spline
+   * through the waypoint initial guess points and these segment initial guess
+   * points is used as the initial guess of the robot's pose over the
+   * trajectory.
    *
    * @param fromIndex index of the waypoint the initial guess point
    *                 comes immediately after
@@ -115,6 +155,28 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
    */
   void SgmtObstacle(size_t fromIndex, size_t toIndex, const Obstacle& obstacle);
 
+  /**
+   * Set the field whose obstacles segments can avoid. The field is referenced,
+   * not copied, so many paths can share it.
+   *
+   * @param field The field.
+   */
+  void SetField(std::shared_ptr<const FieldModel> field);
+
+  /**
+   * Make the continuum of state between two waypoints avoid the field's
+   * obstacles. Their constraints are generated when a generator builds its
+   * problem, and only for obstacles near the segment's initial guess.
+   *
+   * @param fromIndex index of the waypoint at the beginning of the continuum
+   * @param toIndex index of the waypoint at the end of the continuum
+   * @param cullDistance How far (m) from the initial guess, beyond the bumpers,
+   *   obstacles are still avoided. Infinity avoids every obstacle.
+   */
+  void SgmtFieldObstacles(
+      size_t fromIndex, size_t toIndex,
+      double cullDistance = std::numeric_limits<double>::infinity());
+
   /**
    * Apply a constraint at a waypoint.
    *
@@ -126,6 +188,16 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
     path.waypoints.at(index).waypointConstraints.push_back(constraint);
   }
 
+  /**
+   * Remove every constraint applied at a waypoint. Its initial guess points
+   * are kept.
+   *
+   * @param index Index of the waypoint.
+   */
+  void ClearWptConstraints(size_t index) {
+    path.waypoints.at(index).waypointConstraints.clear();
+  }
+
   /**
    * Apply a custom holonomic constraint to the continuum of state between two
    * waypoints.
@@ -163,13 +235,35 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
   const std::vector<size_t>& GetControlIntervalCounts() const;
 
   /**
-   * Calculate a discrete, linear initial guess of the x, y, and heading
-   * of the robot that goes through each segment.
+   * Calculate a discrete initial guess of the x, y, and heading of the robot
+   * that follows a smooth spline through each initial guess point.
+   *
+   * Segments with obstacles and no segment initial guess points are routed
+   * around the obstacles by InitialGuessPlanner, falling back to the direct
+   * route if it can't find one. If a drivetrain is set, the guess is then
+   * retimed with TimeParameterizeInitialGuess so its velocities, accelerations,
+   * and module forces respect the drivetrain's limits.
    *
    * @return the initial guess, as a solution
    */
   SwerveSolution CalculateInitialGuess() const;
 
+  /**
+   * Returns a path builder for the part of this path between two waypoints.
+   *
+   * The new path's waypoints, constraints, obstacles, initial guess points, and
+   * control interval counts are those of this path from fromIndex through
+   * toIndex, and its objective is this path's. Its first waypoint keeps its
+   * waypoint constraints but has no segment leading up to it. Total time
+   * constraints and intermediate callbacks aren't copied, since they apply to
+   * the whole path.
+   *
+   * @param fromIndex Index of the new path's first waypoint.
+   * @param toIndex Index of the new path's last waypoint.
+   * @return The path builder.
+   */
+  SwervePathBuilder Slice(size_t fromIndex, size_t toIndex) const;
+
   /**
    * Add a callback to retrieve the state of the solver as a SwerveSolution.
    * This callback will run on every iteration of the solver.
@@ -181,10 +275,31 @@ class TRAJOPT_DLLEXPORT SwervePathBuilder {
   void AddIntermediateCallback(
       const std::function<void(SwerveSolution&, int64_t)> callback);
 
+  /**
+   * Set the largest number of times per second the intermediate callbacks are
+   * called. The default is 60. Building each intermediate SwerveSolution takes
+   * time away from the solver, so previews of long solves may want fewer.
+   *
+   * @param rate The rate (Hz). Must be positive. Infinity calls them on every
+   *     iteration.
+   */
+  void SetCallbackRate(double rate);
+
+  /**
+   * Set whether the intermediate callbacks are called on a thread of their own
+   * instead of the solver's. The solver then never waits for them; they always
+   * get the newest update, and updates that arrive while they're busy are
+   * dropped.
+   *
+   * @param enabled True to call them on a thread of their own.
+   */
+  void SetCallbackThread(bool enabled);
+
  private:
   SwervePath path;
 
-  std::vector<Bumpers> bumpers;
+  /// The obstacles applied to the segment ending at each waypoint.
+  std::vector<std::vector<Obstacle>> segmentObstacles;
 
   std::vector<std::vector<Pose2d>> initialGuessPoints;
   std::vector<size_t> controlIntervalCounts;
@@ -0,0 +1,66 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "trajopt/path/Path.hpp"
+#include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * An immutable snapshot of a SwervePathBuilder.
+ *
+ * Generators reference a spec by std::shared_ptr instead of copying the path,
+ * so generations of the same path share one copy of its waypoints,
+ * constraints, and obstacles. Every member function is thread-safe.
+ */
+class TRAJOPT_DLLEXPORT SwervePathSpec {
+ public:
+  /**
+   * Constructs a SwervePathSpec. Pass the path builder as an rvalue to avoid
+   * copying it.
+   *
+   * @param pathBuilder The path builder.
+   */
+  explicit SwervePathSpec(SwervePathBuilder pathBuilder)
+      : m_pathBuilder{std::move(pathBuilder)} {}
+
+  /**
+   * Returns the path builder the spec was made from.
+   */
+  const SwervePathBuilder& GetPathBuilder() const { return m_pathBuilder; }
+
+  /**
+   * Returns the path.
+   */
+  const SwervePath& GetPath() const { return m_pathBuilder.GetPath(); }
+
+  /**
+   * Returns the number of control intervals of each segment.
+   */
+  const std::vector<size_t>& GetControlIntervalCounts() const {
+    return m_pathBuilder.GetControlIntervalCounts();
+  }
+
+  /**
+   * Returns the path builder's initial guess. It's calculated the first time
+   * it's needed, then shared.
+   */
+  const SwerveSolution& GetInitialGuess() const;
+
+ private:
+  SwervePathBuilder m_pathBuilder;
+
+  mutable std::once_flag m_initialGuessFlag;
+  mutable std::optional<SwerveSolution> m_initialGuess;
+};
+
+}  // namespace trajopt
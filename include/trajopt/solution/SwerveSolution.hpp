@@ -50,6 +50,19 @@ struct TRAJOPT_DLLEXPORT SwerveSolution {
 
   /// The y forces for each module.
   std::vector<std::vector<double>> moduleFY;
+
+  /// True if the solver ran out of time or iterations, or was canceled, and
+  /// this is the best iterate it found that satisfied the constraints to within
+  /// GenerationOptions::anytimeTolerance.
+  bool suboptimal = false;
+
+  /// The largest constraint violation of a suboptimal solution. Converged
+  /// solutions satisfy the constraints to within the solver tolerance, and
+  /// this is zero for them.
+  double constraintViolation = 0.0;
+
+  /// The number of solver iterations it took to find this solution.
+  int iterations = 0;
 };
 
 }  // namespace trajopt
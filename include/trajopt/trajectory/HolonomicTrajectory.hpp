@@ -2,10 +2,10 @@
 
 #pragma once
 
-#include <cmath>
 #include <utility>
 #include <vector>
 
+#include "trajopt/geometry/BatchGeometry.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
 #include "trajopt/trajectory/HolonomicTrajectorySample.hpp"
 #include "trajopt/util/SymbolExports.hpp"
@@ -36,16 +36,19 @@ class TRAJOPT_DLLEXPORT HolonomicTrajectory {
    * @param solution The swerve solution.
    */
   explicit HolonomicTrajectory(const SwerveSolution& solution) {
+    std::vector<double> headings(solution.x.size());
+    BatchRadians(solution.thetacos, solution.thetasin, headings);
+
     double ts = 0.0;
+    samples.reserve(solution.x.size());
     for (size_t samp = 0; samp < solution.x.size(); ++samp) {
       if (samp != 0) {
         ts += solution.dt[samp - 1];
       }
-      samples.emplace_back(
-          ts, solution.x[samp], solution.y[samp],
-          std::atan2(solution.thetasin[samp], solution.thetacos[samp]),
-          solution.vx[samp], solution.vy[samp], solution.omega[samp],
-          solution.moduleFX[samp], solution.moduleFY[samp]);
+      samples.emplace_back(ts, solution.x[samp], solution.y[samp],
+                           headings[samp], solution.vx[samp],
+                           solution.vy[samp], solution.omega[samp],
+                           solution.moduleFX[samp], solution.moduleFY[samp]);
     }
   }
 };
@@ -0,0 +1,24 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * Counts of the intermediate solutions a generator sent to its path's
+ * callbacks. Solver iterations skipped by the callback rate aren't counted.
+ */
+struct TRAJOPT_DLLEXPORT CallbackCounters {
+  /// The number of solutions the callbacks were called with.
+  uint64_t delivered = 0;
+
+  /// The number of solutions replaced by a newer one before the callback
+  /// thread took them. Only callbacks on a thread of their own drop solutions.
+  uint64_t dropped = 0;
+};
+
+}  // namespace trajopt
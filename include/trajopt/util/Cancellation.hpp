@@ -8,6 +8,12 @@
 
 namespace trajopt {
 
+/**
+ * Returns the process-wide cancellation counter. Incrementing it cancels every
+ * generation running at the time: each one records the counter's value when it
+ * starts and stops once the counter differs from it, so starting a generation
+ * never undoes a cancellation meant for another one.
+ */
 TRAJOPT_DLLEXPORT std::atomic<int>& GetCancellationFlag();
 
 }  // namespace trajopt
@@ -0,0 +1,144 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/geometry/Rotation2.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+
+namespace trajopt {
+
+/**
+ * Generates an initial guess that follows a cubic Hermite spline through the
+ * waypoint and segment initial guess points.
+ *
+ * Unlike GenerateLinearInitialGuess, the guess's direction of travel doesn't
+ * jump at every guess point. Each knot's tangent is the chord-length-weighted
+ * central difference of its neighbors (the spline's ends use one-sided
+ * differences), so unevenly spaced knots overshoot little. Headings are
+ * unwrapped so they take the shortest way around the circle and are
+ * interpolated the same way.
+ *
+ * Samples are assigned to the spans between guess points the same way
+ * GenerateLinearInitialGuess assigns them, so the guess passes through every
+ * guess point at the same sample.
+ *
+ * @param initialGuessPoints The initial guess points of each waypoint, preceded
+ *     by the segment initial guess points leading up to it.
+ * @param controlIntervalCounts The number of control intervals in each
+ *     segment.
+ * @return The initial guess.
+ */
+template <typename Solution>
+inline Solution GenerateSplineInitialGuess(
+    const std::vector<std::vector<Pose2d>>& initialGuessPoints,
+    const std::vector<size_t> controlIntervalCounts) {
+  size_t wptCnt = controlIntervalCounts.size() + 1;
+  size_t sampTot = GetIndex(controlIntervalCounts, wptCnt, 0);
+
+  // Flatten the guess points into knots, recording how many samples each span
+  // after a knot gets
+  std::vector<Pose2d> knots{initialGuessPoints.front().back()};
+  std::vector<size_t> spanSamples;
+  for (size_t wptIndex = 1; wptIndex < wptCnt; ++wptIndex) {
+    const auto& guessPoints = initialGuessPoints.at(wptIndex);
+    size_t N_sgmt = controlIntervalCounts.at(wptIndex - 1);
+    size_t N_guessSgmt = N_sgmt / guessPoints.size();
+    for (size_t guessPointIndex = 0; guessPointIndex < guessPoints.size();
+         ++guessPointIndex) {
+      knots.push_back(guessPoints.at(guessPointIndex));
+      if (guessPointIndex + 1 < guessPoints.size()) {
+        spanSamples.push_back(N_guessSgmt);
+      } else {
+        spanSamples.push_back(N_sgmt - (guessPoints.size() - 1) * N_guessSgmt);
+      }
+    }
+  }
+  size_t knotCnt = knots.size();
+
+  std::vector<double> knotX(knotCnt);
+  std::vector<double> knotY(knotCnt);
+  std::vector<double> knotTheta(knotCnt);
+  for (size_t i = 0; i < knotCnt; ++i) {
+    knotX[i] = knots[i].X();
+    knotY[i] = knots[i].Y();
+    knotTheta[i] = i == 0 ? knots[i].Rotation().Radians()
+                          : knotTheta[i - 1] + (knots[i].Rotation() -
+                                                knots[i - 1].Rotation())
+                                                   .Radians();
+  }
+
+  // Chord length of each span
+  std::vector<double> spanLength(knotCnt - 1);
+  for (size_t i = 0; i + 1 < knotCnt; ++i) {
+    spanLength[i] =
+        std::hypot(knotX[i + 1] - knotX[i], knotY[i + 1] - knotY[i]);
+  }
+
+  // Derivative of each channel with respect to chord length at each knot
+  auto slopes = [&](const std::vector<double>& values) {
+    std::vector<double> result(knotCnt, 0.0);
+    for (size_t i = 0; i < knotCnt; ++i) {
+      size_t prev = i == 0 ? 0 : i - 1;
+      size_t next = i + 1 == knotCnt ? i : i + 1;
+      double length = 0.0;
+      for (size_t span = prev; span < next; ++span) {
+        length += spanLength[span];
+      }
+      if (length > 0.0) {
+        result[i] = (values[next] - values[prev]) / length;
+      }
+    }
+    return result;
+  };
+  auto slopeX = slopes(knotX);
+  auto slopeY = slopes(knotY);
+  auto slopeTheta = slopes(knotTheta);
+
+  Solution initialGuess;
+
+  initialGuess.x.reserve(sampTot);
+  initialGuess.y.reserve(sampTot);
+  initialGuess.thetacos.reserve(sampTot);
+  initialGuess.thetasin.reserve(sampTot);
+  initialGuess.dt.reserve(sampTot);
+
+  initialGuess.x.push_back(knotX.front());
+  initialGuess.y.push_back(knotY.front());
+  initialGuess.thetacos.push_back(std::cos(knotTheta.front()));
+  initialGuess.thetasin.push_back(std::sin(knotTheta.front()));
+
+  for (size_t i = 0; i < sampTot; i++) {
+    initialGuess.dt.push_back((wptCnt * 5.0) / sampTot);
+  }
+
+  for (size_t span = 0; span + 1 < knotCnt; ++span) {
+    double length = spanLength[span];
+    auto hermite = [&](const std::vector<double>& values,
+                       const std::vector<double>& slope, double u) {
+      double u2 = u * u;
+      double u3 = u2 * u;
+      return (2 * u3 - 3 * u2 + 1) * values[span] +
+             (u3 - 2 * u2 + u) * length * slope[span] +
+             (-2 * u3 + 3 * u2) * values[span + 1] +
+             (u3 - u2) * length * slope[span + 1];
+    };
+
+    size_t samples = spanSamples[span];
+    for (size_t sample = 1; sample <= samples; ++sample) {
+      double u = static_cast<double>(sample) / samples;
+      double theta = hermite(knotTheta, slopeTheta, u);
+      initialGuess.x.push_back(hermite(knotX, slopeX, u));
+      initialGuess.y.push_back(hermite(knotY, slopeY, u));
+      initialGuess.thetacos.push_back(std::cos(theta));
+      initialGuess.thetasin.push_back(std::sin(theta));
+    }
+  }
+
+  return initialGuess;
+}
+
+}  // namespace trajopt
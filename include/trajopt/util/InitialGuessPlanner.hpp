@@ -0,0 +1,81 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/obstacle/Bumpers.hpp"
+#include "trajopt/obstacle/Obstacle.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+/**
+ * Plans a collision-free polyline around obstacles for use as an initial
+ * guess.
+ *
+ * The robot is treated as a circle enclosing every bumper, and each obstacle is
+ * inflated by that circle's radius plus both safety distances. Candidate
+ * corners are placed around every inflated obstacle vertex, and A* searches the
+ * visibility graph between them. The graph's edges are only checked when A*
+ * reaches them, so planning around a handful of obstacles takes well under a
+ * millisecond.
+ *
+ * Because the robot's circle is conservative, narrow gaps the solver could
+ * squeeze through may be reported as blocked.
+ */
+class TRAJOPT_DLLEXPORT InitialGuessPlanner {
+ public:
+  /**
+   * Constructs an InitialGuessPlanner.
+   *
+   * @param bumpers The robot's bumpers. If empty, there's nothing to keep away
+   *     from the obstacles, so every straight line is collision-free.
+   * @param obstacles The obstacles to plan around.
+   */
+  InitialGuessPlanner(const std::vector<Bumpers>& bumpers,
+                      const std::vector<Obstacle>& obstacles);
+
+  /**
+   * Returns the corners of a collision-free polyline from start to goal.
+   *
+   * If the start or goal is already too close to an obstacle, the polyline is
+   * allowed to pass through that obstacle on its first or last edge
+   * respectively, so the robot can still leave or reach it.
+   *
+   * @param start The start of the polyline.
+   * @param goal The end of the polyline.
+   * @return The corners strictly between start and goal on success (empty if
+   *     the straight line is collision-free), or a string containing a failure
+   *     reason if the obstacles block every route.
+   */
+  expected<std::vector<Translation2d>, std::string> Plan(
+      const Translation2d& start, const Translation2d& goal) const;
+
+  /**
+   * Returns segment initial guess points for a collision-free polyline from
+   * start to goal, with headings interpolated by distance along the polyline.
+   *
+   * @param start The pose at the start of the segment.
+   * @param goal The pose at the end of the segment.
+   * @return The poses strictly between start and goal on success, or a string
+   *     containing a failure reason if the obstacles block every route.
+   */
+  expected<std::vector<Pose2d>, std::string> PlanPoses(
+      const Pose2d& start, const Pose2d& goal) const;
+
+ private:
+  struct InflatedObstacle {
+    std::vector<Translation2d> points;
+    double radius;
+  };
+
+  std::vector<InflatedObstacle> m_obstacles;
+  std::vector<Translation2d> m_corners;
+};
+
+}  // namespace trajopt
@@ -0,0 +1,133 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "trajopt/drivetrain/SwerveDrivetrain.hpp"
+#include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+/**
+ * One segment of a solved swerve trajectory, moved so it starts at the origin
+ * with a heading of zero.
+ */
+struct TRAJOPT_DLLEXPORT SwervePrimitive {
+  /// The segment's end pose relative to its start pose.
+  Pose2d delta;
+
+  /// The segment's total time (s).
+  double totalTime;
+
+  /// The segment's samples, including the one at its start. dt is unused.
+  SwerveSolution samples;
+};
+
+/**
+ * A collection of previously solved swerve trajectory segments for one
+ * drivetrain, used to build initial guesses for new paths.
+ *
+ * Because a swerve drivetrain's dynamics don't depend on where it is on the
+ * field or which way the field is rotated, a solved segment can be moved to
+ * start at any pose and still be dynamically feasible. Segments are looked up
+ * with a k-d tree by how far their end pose is from their start pose, with
+ * heading differences weighted by how far the drivetrain's farthest wheel
+ * travels per radian.
+ */
+class TRAJOPT_DLLEXPORT PrimitiveLibrary {
+ public:
+  /**
+   * Constructs an empty PrimitiveLibrary.
+   *
+   * @param drivetrain The drivetrain the primitives were solved for.
+   */
+  explicit PrimitiveLibrary(SwerveDrivetrain drivetrain);
+
+  /**
+   * Returns the drivetrain the primitives were solved for.
+   */
+  const SwerveDrivetrain& Drivetrain() const { return m_drivetrain; }
+
+  /**
+   * Returns the number of primitives in the library.
+   */
+  size_t Size() const { return m_primitives.size(); }
+
+  /**
+   * Adds every segment of a solved trajectory to the library.
+   *
+   * @param solution The solved trajectory.
+   * @param controlIntervalCounts The number of control intervals in each
+   *     segment of the solution.
+   * @return Nothing on success, or a string containing a failure reason if the
+   *     solution's dimensions don't match the control interval counts or the
+   *     drivetrain.
+   */
+  expected<void, std::string> Add(
+      const SwerveSolution& solution,
+      const std::vector<size_t>& controlIntervalCounts);
+
+  /**
+   * Returns the primitive whose end pose relative to its start pose is closest
+   * to the given segment's, or nullptr if the library is empty.
+   *
+   * @param start The segment's start pose.
+   * @param end The segment's end pose.
+   */
+  const SwervePrimitive* Nearest(const Pose2d& start, const Pose2d& end) const;
+
+  /**
+   * Builds an initial guess for a path from the nearest primitives.
+   *
+   * Each segment of the path's own initial guess whose nearest primitive is
+   * within maxDistance is replaced by that primitive, resampled to the
+   * segment's control interval count and moved to the segment's start pose.
+   * The difference between the primitive's end and the segment's end is spread
+   * linearly along the segment so the guess still passes through every
+   * waypoint. Other segments keep the path's own initial guess.
+   *
+   * @param path The path.
+   * @param maxDistance The largest distance (m) between a segment's and a
+   *     primitive's end poses relative to their start poses for the primitive
+   *     to be used.
+   * @return The initial guess on success, or a string containing a failure
+   *     reason if the path's drivetrain doesn't match the library's.
+   */
+  expected<SwerveSolution, std::string> InitialGuess(
+      const SwervePathBuilder& path,
+      double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+ private:
+  SwerveDrivetrain m_drivetrain;
+
+  /// Wheel travel (m) per radian of rotation.
+  double m_headingWeight = 0.0;
+
+  std::vector<SwervePrimitive> m_primitives;
+
+  /// Each primitive's k-d tree key.
+  std::vector<std::array<double, 3>> m_keys;
+
+  /// Primitive indices arranged as an implicit k-d tree. The median of each
+  /// range is the node splitting it.
+  std::vector<size_t> m_tree;
+
+  void BuildTree(size_t begin, size_t end, size_t depth);
+
+  void SearchTree(size_t begin, size_t end, size_t depth,
+                  const std::array<double, 3>& key, size_t& nearest,
+                  double& nearestSquaredDistance) const;
+
+  std::array<double, 3> Key(const Pose2d& delta) const;
+};
+
+}  // namespace trajopt
@@ -0,0 +1,46 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "trajopt/drivetrain/SwerveDrivetrain.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+
+namespace trajopt {
+
+/**
+ * Retimes a geometric initial guess so its states are consistent with the
+ * drivetrain's limits.
+ *
+ * The guess's poses are treated as a path which the robot drives along from
+ * rest to rest with a trapezoidal profile. The distance along the path counts
+ * both translation and the wheel travel needed for rotation, so the profile's
+ * maximum velocity is the slowest module's maximum wheel speed and its maximum
+ * acceleration is the smaller of the linear and angular accelerations the
+ * modules' combined force allows.
+ *
+ * Each segment's samples are spaced evenly in time along the profile. The
+ * velocities and accelerations are backward differences of the resampled poses,
+ * matching the generator's kinematics constraints, and the module forces are
+ * the smallest equal split that produces the net force and torque.
+ *
+ * Sharp corners in the path, including abrupt switches between translating
+ * and rotating, aren't slowed for, so the guess can still exceed the module
+ * limits around them.
+ *
+ * @param guess The geometric initial guess. Only its poses are used.
+ * @param drivetrain The drivetrain.
+ * @param controlIntervalCounts The number of control intervals in each
+ *     segment.
+ * @return The retimed initial guess, or the geometric guess unchanged if the
+ *     drivetrain has no modules or the path has no length.
+ */
+TRAJOPT_DLLEXPORT SwerveSolution
+TimeParameterizeInitialGuess(const SwerveSolution& guess,
+                             const SwerveDrivetrain& drivetrain,
+                             const std::vector<size_t>& controlIntervalCounts);
+
+}  // namespace trajopt
@@ -0,0 +1,115 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "trajopt/path/Path.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/SymbolExports.hpp"
+#include "trajopt/util/expected"
+
+namespace trajopt {
+
+/**
+ * The largest violation of one path constraint over the samples it applies to.
+ */
+struct TRAJOPT_DLLEXPORT ConstraintViolation {
+  /// Index of the waypoint whose constraint list contains the constraint.
+  size_t wptIndex = 0;
+
+  /// Index of the constraint within that waypoint's constraint list.
+  size_t constraintIndex = 0;
+
+  /// Index of the sample with the largest violation.
+  size_t sampleIndex = 0;
+
+  /// The largest violation, or zero if the constraint is satisfied everywhere.
+  /// The units are those of the constraint's Evaluate() function.
+  double violation = 0.0;
+};
+
+/**
+ * The result of checking a swerve solution against a swerve path.
+ */
+struct TRAJOPT_DLLEXPORT TrajectoryValidation {
+  /// The largest violation of each waypoint constraint, in waypoint order.
+  std::vector<ConstraintViolation> waypointConstraints;
+
+  /// The largest violation of each segment constraint, in waypoint order.
+  std::vector<ConstraintViolation> segmentConstraints;
+
+  /// The largest amount any module's wheel speed exceeds its limit (m/s) at
+  /// each sample.
+  std::vector<double> moduleVelocity;
+
+  /// The largest amount any module's force exceeds its limit (N) at each
+  /// sample.
+  std::vector<double> moduleForce;
+
+  /// The largest error in Newton's second law at each sample (N for force,
+  /// N−m for torque).
+  std::vector<double> dynamics;
+
+  /// The largest violation of any of the path's field obstacles at each sample,
+  /// for the segments that avoid them.
+  std::vector<double> fieldObstacles;
+
+  /// The largest error in integrating the previous sample's state over the
+  /// time step to each sample (m for position, rad for heading, m/s and rad/s
+  /// for velocity). It's zero at the first sample.
+  std::vector<double> kinematics;
+
+  /// The amount the time step to each sample is negative, or long enough for
+  /// a wheel to travel farther than the closest two modules are apart (s). It's
+  /// zero at the first sample.
+  std::vector<double> timeStep;
+
+  /// The largest violation of any constraint at each sample.
+  std::vector<double> samples;
+
+  /// The amount the total time differs from the path's total time or exceeds
+  /// its maximum total time (s).
+  double totalTime = 0.0;
+
+  /**
+   * Returns the largest violation of any constraint at any sample, or of the
+   * total time.
+   */
+  double MaxViolation() const;
+
+  /**
+   * Returns true if no constraint is violated by more than the tolerance.
+   *
+   * @param tolerance The allowed violation.
+   */
+  bool IsValid(double tolerance = 1e-4) const {
+    return MaxViolation() <= tolerance;
+  }
+};
+
+/**
+ * Checks a swerve solution against every constraint in a swerve path without
+ * building an optimization problem.
+ *
+ * This evaluates every waypoint and segment constraint, and the field obstacles
+ * of the segments that avoid them, with its Evaluate() function, along with
+ * the module velocity limits, module force limits,
+ * dynamics, kinematics, time step bounds, and total time bounds the trajectory
+ * generator imposes.
+ *
+ * @param solution The solution to check. It has one dt per control interval,
+ *     like the generator's solutions, or one per sample, like initial guesses.
+ * @param path The path the solution should satisfy.
+ * @param controlIntervalCounts The number of control intervals in each segment
+ *     of the solution.
+ * @return The violations on success, or a string containing a failure reason
+ *     if the solution's dimensions don't match the path.
+ */
+TRAJOPT_DLLEXPORT expected<TrajectoryValidation, std::string>
+ValidateTrajectory(const SwerveSolution& solution, const SwervePath& path,
+                   const std::vector<size_t>& controlIntervalCounts);
+
+}  // namespace trajopt
@@ -0,0 +1,152 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "trajopt/solution/SwerveSolution.hpp"
+#include "trajopt/util/CallbackCounters.hpp"
+
+namespace trajopt::detail {
+
+/**
+ * Calls a path's intermediate callbacks on a thread of its own, so slow
+ * callbacks don't hold up the solver.
+ *
+ * Solutions are passed through three preallocated slots: the solver writes
+ * into one, the callback thread reads from another, and they swap the third
+ * with theirs. The callbacks always get the newest solution, and solutions
+ * they were too slow for are dropped. Slots keep their vectors' storage, so
+ * once they've been filled, reporting doesn't allocate.
+ *
+ * Slot() and Publish() may only be called from one thread at a time.
+ */
+class CallbackReporter {
+ public:
+  /**
+   * Constructs a CallbackReporter and starts its thread.
+   *
+   * @param callbacks The callbacks. They must outlive the reporter.
+   * @param handle The handle passed to the callbacks.
+   */
+  CallbackReporter(
+      const std::vector<std::function<void(SwerveSolution&, int64_t)>>&
+          callbacks,
+      int64_t handle)
+      : m_callbacks{callbacks},
+        m_handle{handle},
+        m_thread{[this] { Deliver(); }} {}
+
+  ~CallbackReporter() {
+    if (m_thread.joinable()) {
+      Stop();
+    }
+  }
+
+  /**
+   * Delivers the solution still pending, then stops the thread. Nothing may be
+   * published afterward.
+   *
+   * @return The final delivered and dropped solution counts.
+   */
+  CallbackCounters Stop() {
+    m_stopping = true;
+    m_published.fetch_add(1, std::memory_order_release);
+    m_published.notify_one();
+    m_thread.join();
+    return Counters();
+  }
+
+  /**
+   * Returns the slot to write the next solution into. It belongs to the solver
+   * until Publish() is called.
+   */
+  SwerveSolution& Slot() { return m_slots[m_back]; }
+
+  /**
+   * Hands the slot to the callback thread, replacing the solution it hasn't
+   * taken yet if there is one. Never blocks.
+   */
+  void Publish() {
+    uint8_t previous =
+        m_shared.exchange(m_back | kFresh, std::memory_order_acq_rel);
+    if (previous & kFresh) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_back = previous & kIndexMask;
+
+    m_published.fetch_add(1, std::memory_order_release);
+    m_published.notify_one();
+  }
+
+  /**
+   * Returns the delivered and dropped solution counts so far.
+   */
+  CallbackCounters Counters() const {
+    return CallbackCounters{m_delivered.load(std::memory_order_relaxed),
+                            m_dropped.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  static constexpr uint8_t kIndexMask = 0b011;
+
+  /// Set in m_shared while its slot holds a solution the thread hasn't taken.
+  static constexpr uint8_t kFresh = 0b100;
+
+  const std::vector<std::function<void(SwerveSolution&, int64_t)>>&
+      m_callbacks;
+  int64_t m_handle;
+
+  std::array<SwerveSolution, 3> m_slots;
+
+  /// The solver's slot.
+  uint8_t m_back = 0;
+
+  /// The callback thread's slot.
+  uint8_t m_front = 1;
+
+  /// The slot being swapped, and whether it's fresh.
+  std::atomic<uint8_t> m_shared = 2;
+
+  /// Incremented on every publish and on stop, so the thread can wait for
+  /// either.
+  std::atomic<uint64_t> m_published = 0;
+  std::atomic<bool> m_stopping = false;
+
+  std::atomic<uint64_t> m_delivered = 0;
+  std::atomic<uint64_t> m_dropped = 0;
+
+  std::thread m_thread;
+
+  void Deliver() {
+    uint64_t seen = 0;
+    while (true) {
+      // Every solution published before the stop is visible once it's seen
+      bool stopping = m_stopping;
+
+      if (m_shared.load(std::memory_order_acquire) & kFresh) {
+        m_front = m_shared.exchange(m_front, std::memory_order_acq_rel) &
+                  kIndexMask;
+        for (auto& callback : m_callbacks) {
+          callback(m_slots[m_front], m_handle);
+        }
+        m_delivered.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      if (stopping) {
+        return;
+      }
+
+      m_published.wait(seen, std::memory_order_acquire);
+      seen = m_published.load(std::memory_order_acquire);
+    }
+  }
+};
+
+}  // namespace trajopt::detail
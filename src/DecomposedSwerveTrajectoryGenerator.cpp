@@ -0,0 +1,528 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/DecomposedSwerveTrajectoryGenerator.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <sleipnir/autodiff/Variable.hpp>
+
+#include "trajopt/SwerveTrajectoryGenerator.hpp"
+#include "trajopt/constraint/AngularVelocityMaxMagnitudeConstraint.hpp"
+#include "trajopt/constraint/Constraint.hpp"
+#include "trajopt/constraint/LinearVelocityMaxMagnitudeConstraint.hpp"
+#include "trajopt/constraint/PoseEqualityConstraint.hpp"
+#include "trajopt/constraint/TranslationEqualityConstraint.hpp"
+#include "trajopt/util/Cancellation.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+#include "trajopt/util/detail/CallbackReporter.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/// Boundary state components: x, y, cos θ, sin θ, vx, vy, and ω.
+using BoundaryState = std::array<double, 7>;
+
+BoundaryState SampleState(const SwerveSolution& solution, size_t index) {
+  // Initial guesses may only have poses
+  if (solution.vx.size() <= index) {
+    return {solution.x.at(index),
+            solution.y.at(index),
+            solution.thetacos.at(index),
+            solution.thetasin.at(index),
+            0.0,
+            0.0,
+            0.0};
+  }
+  return {solution.x.at(index),        solution.y.at(index),
+          solution.thetacos.at(index), solution.thetasin.at(index),
+          solution.vx.at(index),       solution.vy.at(index),
+          solution.omega.at(index)};
+}
+
+/**
+ * Returns which boundary state components a waypoint's constraints already fix.
+ * Constraining them again would make the constraints linearly dependent.
+ */
+std::array<bool, 7> FixedComponents(const Waypoint& waypoint) {
+  std::array<bool, 7> fixed{};
+  for (const auto& constraint : waypoint.waypointConstraints) {
+    if (std::holds_alternative<PoseEqualityConstraint>(constraint)) {
+      fixed[0] = fixed[1] = fixed[2] = fixed[3] = true;
+    } else if (std::holds_alternative<TranslationEqualityConstraint>(
+                   constraint)) {
+      fixed[0] = fixed[1] = true;
+    } else if (auto linear =
+                   std::get_if<LinearVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      if (linear->MaxMagnitude() == 0.0) {
+        fixed[4] = fixed[5] = true;
+      }
+    } else if (auto angular =
+                   std::get_if<AngularVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      if (angular->MaxMagnitude() == 0.0) {
+        fixed[6] = true;
+      }
+    }
+  }
+  return fixed;
+}
+
+/**
+ * Returns the samples in [fromIndex, toIndex] of an initial guess. Channels the
+ * guess doesn't have stay empty.
+ */
+SwerveSolution SliceGuess(const SwerveSolution& guess, size_t fromIndex,
+                          size_t toIndex) {
+  auto slice = [&](const auto& channel) {
+    using Channel = std::remove_cvref_t<decltype(channel)>;
+    if (channel.size() <= toIndex) {
+      return Channel{};
+    }
+    return Channel(channel.begin() + fromIndex, channel.begin() + toIndex + 1);
+  };
+
+  SwerveSolution result;
+  result.dt = slice(guess.dt);
+  result.x = slice(guess.x);
+  result.y = slice(guess.y);
+  result.thetacos = slice(guess.thetacos);
+  result.thetasin = slice(guess.thetasin);
+  result.vx = slice(guess.vx);
+  result.vy = slice(guess.vy);
+  result.omega = slice(guess.omega);
+  result.ax = slice(guess.ax);
+  result.ay = slice(guess.ay);
+  result.alpha = slice(guess.alpha);
+  result.moduleFX = slice(guess.moduleFX);
+  result.moduleFY = slice(guess.moduleFY);
+  return result;
+}
+
+/**
+ * Empties the solution's vectors without releasing their storage.
+ */
+void ClearSolution(SwerveSolution& solution) {
+  for (auto* values :
+       {&solution.dt, &solution.x, &solution.y, &solution.thetacos,
+        &solution.thetasin, &solution.vx, &solution.vy, &solution.omega,
+        &solution.ax, &solution.ay, &solution.alpha}) {
+    values->clear();
+  }
+  solution.moduleFX.clear();
+  solution.moduleFY.clear();
+  solution.suboptimal = false;
+  solution.constraintViolation = 0.0;
+  solution.iterations = 0;
+}
+
+/**
+ * Appends a piece's solution to the stitched solution. Every piece after the
+ * first drops its first sample, which duplicates the previous piece's last.
+ */
+void AppendPiece(SwerveSolution& result, const SwerveSolution& piece,
+                 bool first) {
+  size_t offset = first ? 0 : 1;
+  auto append = [&](auto& to, const auto& from) {
+    to.insert(to.end(), from.begin() + offset, from.end());
+  };
+
+  result.dt.insert(result.dt.end(), piece.dt.begin(), piece.dt.end());
+  append(result.x, piece.x);
+  append(result.y, piece.y);
+  append(result.thetacos, piece.thetacos);
+  append(result.thetasin, piece.thetasin);
+  append(result.vx, piece.vx);
+  append(result.vy, piece.vy);
+  append(result.omega, piece.omega);
+  append(result.ax, piece.ax);
+  append(result.ay, piece.ay);
+  append(result.alpha, piece.alpha);
+  append(result.moduleFX, piece.moduleFX);
+  append(result.moduleFY, piece.moduleFY);
+
+  result.suboptimal = result.suboptimal || piece.suboptimal;
+  result.constraintViolation =
+      std::max(result.constraintViolation, piece.constraintViolation);
+  result.iterations += piece.iterations;
+}
+
+}  // namespace
+
+bool IsWaypointPinned(const SwervePath& path, size_t wptIndex) {
+  bool pose = false;
+  bool linearVelocity = false;
+  bool angularVelocity = false;
+  for (const auto& constraint :
+       path.waypoints.at(wptIndex).waypointConstraints) {
+    if (std::holds_alternative<PoseEqualityConstraint>(constraint)) {
+      pose = true;
+    } else if (auto linear =
+                   std::get_if<LinearVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      linearVelocity |= linear->MaxMagnitude() == 0.0;
+    } else if (auto angular =
+                   std::get_if<AngularVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      angularVelocity |= angular->MaxMagnitude() == 0.0;
+    }
+  }
+  return pose && linearVelocity && angularVelocity;
+}
+
+DecomposedSwerveTrajectoryGenerator::DecomposedSwerveTrajectoryGenerator(
+    SwervePathBuilder pathBuilder, std::vector<size_t> splitWaypoints,
+    DecompositionOptions options, int64_t handle)
+    : DecomposedSwerveTrajectoryGenerator{
+          std::make_shared<const SwervePathSpec>(std::move(pathBuilder)),
+          std::move(splitWaypoints), options, handle} {}
+
+DecomposedSwerveTrajectoryGenerator::DecomposedSwerveTrajectoryGenerator(
+    SwervePathBuilder pathBuilder, SwerveSolution initialGuess,
+    std::vector<size_t> splitWaypoints, DecompositionOptions options,
+    int64_t handle)
+    : DecomposedSwerveTrajectoryGenerator{
+          std::make_shared<const SwervePathSpec>(std::move(pathBuilder)),
+          std::move(initialGuess), std::move(splitWaypoints), options,
+          handle} {}
+
+DecomposedSwerveTrajectoryGenerator::DecomposedSwerveTrajectoryGenerator(
+    std::shared_ptr<const SwervePathSpec> spec,
+    std::vector<size_t> splitWaypoints, DecompositionOptions options,
+    int64_t handle)
+    : m_spec{std::move(spec)},
+      m_callbacks{m_spec->GetPath().callbacks},
+      m_splitWaypoints{std::move(splitWaypoints)},
+      m_options{options},
+      m_handle{handle} {
+  std::sort(m_splitWaypoints.begin(), m_splitWaypoints.end());
+  m_splitWaypoints.erase(
+      std::unique(m_splitWaypoints.begin(), m_splitWaypoints.end()),
+      m_splitWaypoints.end());
+}
+
+DecomposedSwerveTrajectoryGenerator::DecomposedSwerveTrajectoryGenerator(
+    std::shared_ptr<const SwervePathSpec> spec, SwerveSolution initialGuess,
+    std::vector<size_t> splitWaypoints, DecompositionOptions options,
+    int64_t handle)
+    : DecomposedSwerveTrajectoryGenerator{std::move(spec),
+                                          std::move(splitWaypoints), options,
+                                          handle} {
+  // Solutions from Generate() have one dt per control interval, and initial
+  // guesses have one per sample
+  if (initialGuess.dt.size() + 1 == initialGuess.x.size()) {
+    initialGuess.dt.insert(initialGuess.dt.begin(), initialGuess.dt.front());
+  }
+  m_initialGuess = std::move(initialGuess);
+}
+
+expected<SwerveSolution, std::string>
+DecomposedSwerveTrajectoryGenerator::Generate(bool diagnostics) {
+  GenerationOptions options;
+  options.diagnostics = diagnostics;
+  return Generate(options);
+}
+
+expected<SwerveSolution, std::string>
+DecomposedSwerveTrajectoryGenerator::Generate(
+    const GenerationOptions& options) {
+  const auto& path = m_spec->GetPath();
+  const auto& N = m_spec->GetControlIntervalCounts();
+  size_t wptCnt = path.waypoints.size();
+
+  for (size_t wptIndex : m_splitWaypoints) {
+    if (wptIndex == 0 || wptIndex + 1 >= wptCnt) {
+      return unexpected{
+          std::string{"Paths can only be split at interior waypoints"}};
+    }
+  }
+
+  const auto& fullGuess =
+      m_initialGuess ? *m_initialGuess : m_spec->GetInitialGuess();
+
+  if (m_splitWaypoints.empty()) {
+    return SwerveTrajectoryGenerator{m_spec, fullGuess, m_handle, false}
+        .Generate(options);
+  }
+
+  if (path.totalTime || path.maxTotalTime) {
+    return unexpected{
+        std::string{"Paths with total time constraints can't be split"}};
+  }
+
+  // Piece i spans waypoints bounds[i] through bounds[i + 1]
+  std::vector<size_t> bounds{0};
+  bounds.insert(bounds.end(), m_splitWaypoints.begin(),
+                m_splitWaypoints.end());
+  bounds.push_back(wptCnt - 1);
+  size_t pieceCnt = bounds.size() - 1;
+
+  std::vector<std::shared_ptr<const SwervePathSpec>> pieces;
+  std::vector<SwerveSolution> pieceGuesses;
+  pieces.reserve(pieceCnt);
+  pieceGuesses.reserve(pieceCnt);
+  for (size_t piece = 0; piece < pieceCnt; ++piece) {
+    pieces.push_back(std::make_shared<const SwervePathSpec>(
+        m_spec->GetPathBuilder().Slice(bounds[piece], bounds[piece + 1])));
+    pieceGuesses.push_back(SliceGuess(
+        fullGuess, GetIndex(N, bounds[piece] + 1, 0) - 1,
+        GetIndex(N, bounds[piece + 1] + 1, 0) - 1));
+  }
+
+  // Split i lies between pieces i and i + 1. Only splits that aren't pinned
+  // need the pieces to reach consensus.
+  size_t splitCnt = pieceCnt - 1;
+  std::vector<bool> consensus(splitCnt);
+  std::vector<BoundaryState> z(splitCnt);
+  std::vector<BoundaryState> lambdaEnd(splitCnt);
+  std::vector<BoundaryState> lambdaStart(splitCnt);
+  std::vector<BoundaryState> stateEnd(splitCnt);
+  std::vector<BoundaryState> stateStart(splitCnt);
+  for (size_t split = 0; split < splitCnt; ++split) {
+    consensus[split] = !IsWaypointPinned(path, bounds[split + 1]);
+    z[split] =
+        SampleState(fullGuess, GetIndex(N, bounds[split + 1] + 1, 0) - 1);
+    lambdaEnd[split].fill(0.0);
+    lambdaStart[split].fill(0.0);
+  }
+
+  std::vector<std::optional<expected<SwerveSolution, std::string>>> results(
+      pieceCnt);
+  bool done = false;
+  int iteration = 0;
+
+  // Runs on one thread after every piece has solved an iteration, while the
+  // others wait
+  auto updateConsensus = [&]() noexcept {
+    double residual = 0.0;
+    for (size_t split = 0; split < splitCnt; ++split) {
+      if (!consensus[split]) {
+        continue;
+      }
+      double rho = m_options.penalty;
+      for (size_t i = 0; i < z[split].size(); ++i) {
+        double zPrev = z[split][i];
+        z[split][i] =
+            0.5 * (stateEnd[split][i] + lambdaEnd[split][i] / rho +
+                   stateStart[split][i] + lambdaStart[split][i] / rho);
+        lambdaEnd[split][i] += rho * (stateEnd[split][i] - z[split][i]);
+        lambdaStart[split][i] += rho * (stateStart[split][i] - z[split][i]);
+        residual = std::max(
+            {residual, std::abs(stateEnd[split][i] - z[split][i]),
+             std::abs(stateStart[split][i] - z[split][i]),
+             std::abs(z[split][i] - zPrev)});
+      }
+    }
+
+    ++iteration;
+    bool failed = std::any_of(results.begin(), results.end(),
+                              [](const auto& result) { return !*result; });
+    done = failed || residual < m_options.tolerance ||
+           iteration >= m_options.maxIterations;
+  };
+  std::barrier sync{static_cast<std::ptrdiff_t>(pieceCnt), updateConsensus};
+
+  // Calls the path's callbacks on a thread of their own if requested. Reports
+  // are serialized by the callback mutex.
+  std::optional<detail::CallbackReporter> reporter;
+  if (path.callbackThread && !m_callbacks.empty()) {
+    reporter.emplace(m_callbacks, m_handle);
+  }
+
+  // Stitches the pieces' latest states together for the path's callbacks
+  std::mutex callbackMutex;
+  std::vector<std::optional<SwerveSolution>> latest(pieceCnt);
+  SwerveSolution stitched;
+  std::chrono::steady_clock::time_point lastFrameTime;
+  auto publish = [&](size_t piece, SwerveSolution state) {
+    std::chrono::duration<double> timePerFrame{1.0 / path.callbackRate};
+
+    std::scoped_lock lock{callbackMutex};
+    latest[piece] = std::move(state);
+
+    // FPS limit on sending updates
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastFrameTime < timePerFrame ||
+        std::any_of(latest.begin(), latest.end(),
+                    [](const auto& solution) { return !solution; })) {
+      return;
+    }
+
+    lastFrameTime = now;
+
+    auto& soln = reporter ? reporter->Slot() : stitched;
+    ClearSolution(soln);
+    for (size_t i = 0; i < pieceCnt; ++i) {
+      AppendPiece(soln, *latest[i], i == 0);
+    }
+    if (reporter) {
+      reporter->Publish();
+      return;
+    }
+    for (auto& callback : m_callbacks) {
+      callback(soln, m_handle);
+    }
+    ++m_callbackCounters.delivered;
+  };
+
+  // Every piece's solves belong to this generation
+  int cancellationGeneration = GetCancellationFlag();
+
+  // The timeout covers every solve of every piece
+  auto startTime = std::chrono::steady_clock::now();
+
+  // Each piece's problem is built, solved, and destroyed on its own thread
+  auto solvePiece = [&](size_t piece) {
+    SwerveTrajectoryGenerator generator{pieces[piece], pieceGuesses[piece],
+                                        m_handle, false};
+
+    // Pieces don't have the path's callbacks, which expect states for the whole
+    // path
+    generator.callbacks.clear();
+    if (!m_callbacks.empty()) {
+      generator.callbacks.emplace_back([&, piece] {
+        publish(piece, generator.ConstructSwerveSolution());
+      });
+    }
+
+    size_t last = generator.x.size() - 1;
+    auto stateVariables = [&](size_t index) {
+      return std::array{generator.x[index],        generator.y[index],
+                        generator.thetacos[index], generator.thetasin[index],
+                        generator.vx[index],       generator.vy[index],
+                        generator.omega[index]};
+    };
+
+    auto pathObjective = [&] {
+      if (options.mode == GenerationMode::kFeasible) {
+        return sleipnir::Variable{0.0};
+      }
+      return generator.objective;
+    };
+
+    // Boundaries of this piece that take part in consensus, as (split, is the
+    // piece's end) pairs
+    std::vector<std::pair<size_t, bool>> boundaries;
+    if (piece > 0 && consensus[piece - 1]) {
+      boundaries.emplace_back(piece - 1, false);
+    }
+    if (piece < splitCnt && consensus[piece]) {
+      boundaries.emplace_back(piece, true);
+    }
+
+    // The piece's result counts the iterations of every one of its solves
+    int iterations = 0;
+    auto solve = [&] {
+      GenerationOptions pieceOptions = options;
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - startTime;
+      pieceOptions.timeout = std::max(options.timeout - elapsed,
+                                      std::chrono::duration<double>::zero());
+      auto result = generator.Solve(pieceOptions, cancellationGeneration);
+      if (result) {
+        iterations += result->iterations;
+        result->iterations = iterations;
+      }
+      return result;
+    };
+
+    // A piece without consensus boundaries has the same problem every round,
+    // so it's solved once and then only waits for the others each round
+    if (boundaries.empty()) {
+      generator.problem.Minimize(pathObjective());
+      results[piece] = solve();
+    }
+
+    while (true) {
+      if (!boundaries.empty()) {
+        auto objective = pathObjective();
+        for (auto [split, isEnd] : boundaries) {
+          const auto& lambda = isEnd ? lambdaEnd[split] : lambdaStart[split];
+          auto state = stateVariables(isEnd ? last : 0);
+          for (size_t i = 0; i < state.size(); ++i) {
+            auto error = state[i] - z[split][i];
+            objective +=
+                lambda[i] * error + 0.5 * m_options.penalty * error * error;
+          }
+        }
+        generator.problem.Minimize(std::move(objective));
+
+        results[piece] = solve();
+        if (*results[piece]) {
+          for (auto [split, isEnd] : boundaries) {
+            auto& state = isEnd ? stateEnd[split] : stateStart[split];
+            state = SampleState(**results[piece], isEnd ? last : 0);
+          }
+        }
+      }
+
+      sync.arrive_and_wait();
+      if (done) {
+        break;
+      }
+    }
+
+    // Fix the boundaries to the consensus so the pieces meet exactly. The
+    // components the split waypoint already fixes are left to it.
+    if (*results[piece] && !boundaries.empty()) {
+      for (auto [split, isEnd] : boundaries) {
+        auto state = stateVariables(isEnd ? last : 0);
+        auto fixed = FixedComponents(path.waypoints[bounds[split + 1]]);
+        auto target = z[split];
+        double norm = std::hypot(target[2], target[3]);
+        target[2] /= norm;
+        target[3] /= norm;
+        for (size_t i = 0; i < state.size(); ++i) {
+          if (!fixed[i]) {
+            generator.problem.SubjectTo(state[i] == target[i]);
+          }
+        }
+      }
+      generator.problem.Minimize(pathObjective());
+      results[piece] = solve();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(pieceCnt);
+  for (size_t piece = 0; piece < pieceCnt; ++piece) {
+    threads.emplace_back(solvePiece, piece);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Delivers the update still pending
+  if (reporter) {
+    auto counters = reporter->Stop();
+    m_callbackCounters.delivered += counters.delivered;
+    m_callbackCounters.dropped += counters.dropped;
+  }
+
+  SwerveSolution result;
+  for (size_t piece = 0; piece < pieceCnt; ++piece) {
+    if (!*results[piece]) {
+      return unexpected{results[piece]->error()};
+    }
+    AppendPiece(result, **results[piece], piece == 0);
+  }
+  return result;
+}
+
+}  // namespace trajopt
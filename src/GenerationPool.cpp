@@ -0,0 +1,163 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/GenerationPool.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "trajopt/SwerveTrajectoryGenerator.hpp"
+
+namespace trajopt {
+
+bool GenerationJob::IsDone() const {
+  std::scoped_lock lock{m_mutex};
+  return m_result.has_value();
+}
+
+void GenerationJob::Cancel() {
+  m_canceled = true;
+}
+
+std::optional<SwerveSolution> GenerationJob::Progress() const {
+  std::scoped_lock lock{m_mutex};
+  return m_progress;
+}
+
+const expected<SwerveSolution, std::string>& GenerationJob::Wait() {
+  std::unique_lock lock{m_mutex};
+  m_doneCondition.wait(lock, [&] { return m_result.has_value(); });
+
+  // The result isn't modified once it's set
+  return *m_result;
+}
+
+void GenerationJob::OnDone(std::function<void()> callback) {
+  {
+    std::scoped_lock lock{m_mutex};
+    if (!m_result) {
+      m_onDone = std::move(callback);
+      return;
+    }
+  }
+
+  callback();
+}
+
+void GenerationJob::Finish(expected<SwerveSolution, std::string> result) {
+  std::function<void()> onDone;
+  {
+    std::scoped_lock lock{m_mutex};
+    m_result = std::move(result);
+    onDone = std::move(m_onDone);
+  }
+  m_doneCondition.notify_all();
+
+  if (onDone) {
+    onDone();
+  }
+}
+
+GenerationPool::GenerationPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  m_running.resize(threadCount);
+  m_threads.reserve(threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+    m_threads.emplace_back(&GenerationPool::Work, this, threadIndex);
+  }
+}
+
+GenerationPool::~GenerationPool() {
+  std::deque<Task> tasks;
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stopping = true;
+    tasks = std::move(m_tasks);
+    for (auto& job : m_running) {
+      if (job) {
+        job->Cancel();
+      }
+    }
+  }
+  m_taskCondition.notify_all();
+
+  for (auto& task : tasks) {
+    task.job->Finish(unexpected{std::string{"The generation was canceled"}});
+  }
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<GenerationJob> GenerationPool::Submit(
+    SwervePathBuilder pathBuilder, GenerationOptions options, int64_t handle) {
+  return Submit(std::make_shared<const SwervePathSpec>(std::move(pathBuilder)),
+                options, handle);
+}
+
+std::shared_ptr<GenerationJob> GenerationPool::Submit(
+    std::shared_ptr<const SwervePathSpec> spec, GenerationOptions options,
+    int64_t handle) {
+  auto job = std::make_shared<GenerationJob>();
+  {
+    std::scoped_lock lock{m_mutex};
+    m_tasks.push_back(Task{job, std::move(spec), options, handle});
+  }
+  m_taskCondition.notify_one();
+
+  return job;
+}
+
+void GenerationPool::Work(size_t threadIndex) {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock lock{m_mutex};
+      m_taskCondition.wait(lock,
+                           [&] { return m_stopping || !m_tasks.empty(); });
+      if (m_stopping) {
+        return;
+      }
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      m_running[threadIndex] = task.job;
+    }
+
+    auto& job = *task.job;
+    if (job.m_canceled) {
+      job.Finish(unexpected{std::string{"The generation was canceled"}});
+    } else {
+      task.options.cancellation = &job.m_canceled;
+
+      // The pool's threads are already busy, so a path with pinned waypoints
+      // is solved whole instead of split into pieces on threads of their own
+      const auto& initialGuess = task.spec->GetInitialGuess();
+      SwerveTrajectoryGenerator generator{task.spec, initialGuess, task.handle,
+                                          false};
+      generator.AddIntermediateCallback(
+          [&job](SwerveSolution& solution, int64_t) {
+            std::scoped_lock lock{job.m_mutex};
+            job.m_progress = solution;
+          });
+      job.Finish(generator.Generate(task.options));
+    }
+
+    std::scoped_lock lock{m_mutex};
+    m_running[threadIndex] = nullptr;
+  }
+}
+
+}  // namespace trajopt
@@ -0,0 +1,274 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/RecedingHorizonSwerveTrajectoryGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/Variable.hpp>
+
+#include "trajopt/path/SwervePathSpec.hpp"
+#include "trajopt/util/Cancellation.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/**
+ * Sets the value of a constant that constraints depend on.
+ *
+ * Sleipnir replaces a zero constant's expression when it's assigned instead of
+ * updating it, which would detach it from the constraints, so the value is
+ * never exactly zero.
+ */
+void SetParameter(sleipnir::Variable& parameter, double value) {
+  parameter.SetValue(value == 0.0 ? std::numeric_limits<double>::denorm_min()
+                                  : value);
+}
+
+}  // namespace
+
+RecedingHorizonSwerveTrajectoryGenerator::
+    RecedingHorizonSwerveTrajectoryGenerator(
+        const SwervePathBuilder& pathBuilder, SwerveSolution reference,
+        GenerationOptions options)
+    : m_N{pathBuilder.GetControlIntervalCounts()},
+      m_totalTime{pathBuilder.GetPath().totalTime},
+      m_maxTotalTime{pathBuilder.GetPath().maxTotalTime},
+      m_options{options} {
+  size_t sgmtCnt = m_N.size();
+  assert(reference.x.size() == GetIndex(m_N, sgmtCnt + 1, 0));
+
+  m_remainders.reserve(sgmtCnt);
+  for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
+    // The robot is somewhere in this segment, so the waypoint before it no
+    // longer applies
+    auto remainderPath = pathBuilder.Slice(sgmtIndex, sgmtCnt);
+    remainderPath.ClearWptConstraints(0);
+
+    auto& remainder = m_remainders.emplace_back();
+    auto remainderGuess = remainderPath.CalculateInitialGuess();
+    remainder.generator.reset(new SwerveTrajectoryGenerator{
+        std::make_shared<const SwervePathSpec>(std::move(remainderPath)),
+        remainderGuess, 0, false});
+
+    auto& generator = *remainder.generator;
+    generator.callbacks.clear();
+
+    std::array state{generator.x[0],        generator.y[0],
+                     generator.thetacos[0], generator.thetasin[0],
+                     generator.vx[0],       generator.vy[0],
+                     generator.omega[0]};
+    for (size_t i = 0; i < state.size(); ++i) {
+      remainder.initialState[i] = sleipnir::Variable{1.0};
+      generator.problem.SubjectTo(state[i] == remainder.initialState[i]);
+    }
+
+    // Slices drop total time constraints, since they apply to the whole path
+    if (m_totalTime) {
+      remainder.remainingTime = sleipnir::Variable{1.0};
+      generator.problem.SubjectTo(generator.TotalTime() ==
+                                  remainder.remainingTime);
+    }
+    if (m_maxTotalTime) {
+      remainder.remainingMaxTime = sleipnir::Variable{1.0};
+      generator.problem.SubjectTo(generator.TotalTime() <=
+                                  remainder.remainingMaxTime);
+    }
+
+    // The options don't change between replans, so neither does the objective
+    if (m_options.mode == GenerationMode::kFeasible) {
+      generator.problem.Minimize(sleipnir::Variable{0.0});
+    }
+  }
+
+  SetPlan(std::move(reference), 0);
+}
+
+RecedingHorizonSwerveTrajectoryGenerator::
+    ~RecedingHorizonSwerveTrajectoryGenerator() = default;
+
+expected<SwerveSolution, std::string>
+RecedingHorizonSwerveTrajectoryGenerator::Replan(
+    const HolonomicTrajectorySample& measured) {
+  double time = std::max(measured.timestamp, 0.0);
+  if (time >= m_planTimes.back()) {
+    return unexpected{std::string{"The current plan has already finished"}};
+  }
+
+  // Find the segment the robot is in
+  size_t sgmtIndex = m_planFirstSgmt;
+  size_t sgmtEndIndex = m_N.at(sgmtIndex);
+  while (m_planTimes[sgmtEndIndex] <= time) {
+    ++sgmtIndex;
+    sgmtEndIndex += m_N.at(sgmtIndex);
+  }
+
+  auto& remainder = m_remainders[sgmtIndex];
+  auto& generator = *remainder.generator;
+
+  std::array<double, 7> state{measured.x,
+                              measured.y,
+                              std::cos(measured.heading),
+                              std::sin(measured.heading),
+                              measured.velocityX,
+                              measured.velocityY,
+                              measured.angularVelocity};
+  for (size_t i = 0; i < state.size(); ++i) {
+    SetParameter(remainder.initialState[i], state[i]);
+  }
+  double elapsedTime = m_planStartTime + time;
+  if (m_totalTime) {
+    SetParameter(remainder.remainingTime, *m_totalTime - elapsedTime);
+  }
+  if (m_maxTotalTime) {
+    SetParameter(remainder.remainingMaxTime, *m_maxTotalTime - elapsedTime);
+  }
+
+  // Start from the current plan, moved to begin at the measured state
+  auto guess = ShiftPlan(sgmtIndex, time);
+  guess.x[0] = state[0];
+  guess.y[0] = state[1];
+  guess.thetacos[0] = state[2];
+  guess.thetasin[0] = state[3];
+  guess.vx[0] = state[4];
+  guess.vy[0] = state[5];
+  guess.omega[0] = state[6];
+  generator.ApplyInitialGuess(guess);
+
+  auto result = generator.Solve(m_options, GetCancellationFlag());
+
+  // The generator only checks anytime results against its path's constraints,
+  // so the measured state and remaining time constraints added here are
+  // checked too
+  if (result && result->suboptimal) {
+    std::array<double, 7> start{result->x[0],        result->y[0],
+                                result->thetacos[0], result->thetasin[0],
+                                result->vx[0],       result->vy[0],
+                                result->omega[0]};
+    double violation = 0.0;
+    for (size_t i = 0; i < state.size(); ++i) {
+      violation = std::max(violation, std::abs(start[i] - state[i]));
+    }
+    double totalTime =
+        std::accumulate(result->dt.begin(), result->dt.end(), 0.0);
+    if (m_totalTime) {
+      violation = std::max(
+          violation, std::abs(totalTime - (*m_totalTime - elapsedTime)));
+    }
+    if (m_maxTotalTime) {
+      violation =
+          std::max(violation, totalTime - (*m_maxTotalTime - elapsedTime));
+    }
+
+    if (violation > m_options.anytimeTolerance) {
+      return unexpected{std::string{
+          "The best iterate doesn't start at the measured state or fit in the "
+          "remaining time"}};
+    }
+    result->constraintViolation =
+        std::max(result->constraintViolation, violation);
+  }
+
+  if (result) {
+    m_planStartTime = elapsedTime;
+    SetPlan(*result, sgmtIndex);
+  }
+  return result;
+}
+
+void RecedingHorizonSwerveTrajectoryGenerator::SetPlan(SwerveSolution plan,
+                                                       size_t firstSgmt) {
+  m_plan = std::move(plan);
+  m_planFirstSgmt = firstSgmt;
+
+  m_planTimes.assign(1, 0.0);
+  for (double dt : m_plan.dt) {
+    m_planTimes.push_back(m_planTimes.back() + dt);
+  }
+}
+
+SwerveSolution RecedingHorizonSwerveTrajectoryGenerator::ShiftPlan(
+    size_t sgmtIndex, double time) const {
+  // Samples of the current plan at the start and end of the segment
+  size_t startIndex = 0;
+  for (size_t index = m_planFirstSgmt; index < sgmtIndex; ++index) {
+    startIndex += m_N[index];
+  }
+  size_t N_sgmt = m_N[sgmtIndex];
+  size_t endIndex = startIndex + N_sgmt;
+  double dt_sgmt = (m_planTimes[endIndex] - time) / N_sgmt;
+
+  SwerveSolution guess;
+  auto lerp = [](double a, double b, double u) { return a + (b - a) * u; };
+
+  // Spread the rest of the robot's segment over its control intervals
+  for (size_t sampIndex = 0; sampIndex <= N_sgmt; ++sampIndex) {
+    double t = time + sampIndex * dt_sgmt;
+    size_t index = std::upper_bound(m_planTimes.begin() + startIndex,
+                                    m_planTimes.begin() + endIndex, t) -
+                   m_planTimes.begin();
+    index = std::clamp(index, startIndex + 1, endIndex);
+    double span = m_planTimes[index] - m_planTimes[index - 1];
+    double u = span > 0.0 ? (t - m_planTimes[index - 1]) / span : 1.0;
+
+    auto sample = [&](const std::vector<double>& channel) {
+      return lerp(channel[index - 1], channel[index], u);
+    };
+
+    double thetacos = sample(m_plan.thetacos);
+    double thetasin = sample(m_plan.thetasin);
+    double norm = std::hypot(thetacos, thetasin);
+
+    guess.dt.push_back(dt_sgmt);
+    guess.x.push_back(sample(m_plan.x));
+    guess.y.push_back(sample(m_plan.y));
+    guess.thetacos.push_back(thetacos / norm);
+    guess.thetasin.push_back(thetasin / norm);
+    guess.vx.push_back(sample(m_plan.vx));
+    guess.vy.push_back(sample(m_plan.vy));
+    guess.omega.push_back(sample(m_plan.omega));
+    guess.ax.push_back(sample(m_plan.ax));
+    guess.ay.push_back(sample(m_plan.ay));
+    guess.alpha.push_back(sample(m_plan.alpha));
+    auto& moduleFX = guess.moduleFX.emplace_back();
+    auto& moduleFY = guess.moduleFY.emplace_back();
+    for (size_t moduleIndex = 0; moduleIndex < m_plan.moduleFX[index].size();
+         ++moduleIndex) {
+      moduleFX.push_back(lerp(m_plan.moduleFX[index - 1][moduleIndex],
+                              m_plan.moduleFX[index][moduleIndex], u));
+      moduleFY.push_back(lerp(m_plan.moduleFY[index - 1][moduleIndex],
+                              m_plan.moduleFY[index][moduleIndex], u));
+    }
+  }
+
+  // Later segments are unchanged
+  for (size_t index = endIndex + 1; index < m_plan.x.size(); ++index) {
+    guess.dt.push_back(m_plan.dt[index - 1]);
+    guess.x.push_back(m_plan.x[index]);
+    guess.y.push_back(m_plan.y[index]);
+    guess.thetacos.push_back(m_plan.thetacos[index]);
+    guess.thetasin.push_back(m_plan.thetasin[index]);
+    guess.vx.push_back(m_plan.vx[index]);
+    guess.vy.push_back(m_plan.vy[index]);
+    guess.omega.push_back(m_plan.omega[index]);
+    guess.ax.push_back(m_plan.ax[index]);
+    guess.ay.push_back(m_plan.ay[index]);
+    guess.alpha.push_back(m_plan.alpha[index]);
+    guess.moduleFX.push_back(m_plan.moduleFX[index]);
+    guess.moduleFY.push_back(m_plan.moduleFY[index]);
+  }
+
+  return guess;
+}
+
+}  // namespace trajopt
@@ -4,10 +4,19 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "trajopt/GenerationOptions.hpp"
+#include "trajopt/GenerationPool.hpp"
 #include "trajopt/SwerveTrajectoryGenerator.hpp"
 #include "trajopt/constraint/AngularVelocityMaxMagnitudeConstraint.hpp"
 #include "trajopt/constraint/LinearAccelerationMaxMagnitudeConstraint.hpp"
@@ -15,13 +24,279 @@
 #include "trajopt/constraint/LinearVelocityMaxMagnitudeConstraint.hpp"
 #include "trajopt/constraint/PointAtConstraint.hpp"
 #include "trajopt/drivetrain/SwerveModule.hpp"
-#include "trajopt/trajectory/HolonomicTrajectory.hpp"
-#include "trajopt/trajectory/HolonomicTrajectorySample.hpp"
+#include "trajopt/geometry/BatchGeometry.hpp"
 #include "trajopt/util/Cancellation.hpp"
 #include "trajoptlib/src/lib.rs.h"
 
 namespace trajopt::rsffi {
 
+namespace {
+
+trajopt::GenerationOptions ToCpp(const GenerationOptions& options) {
+  trajopt::GenerationOptions cppOptions;
+  cppOptions.tolerance = options.tolerance;
+  cppOptions.maxIterations = options.max_iterations;
+  cppOptions.timeout = std::chrono::duration<double>{options.timeout};
+  cppOptions.mode = options.feasibility_only
+                        ? trajopt::GenerationMode::kFeasible
+                        : trajopt::GenerationMode::kOptimal;
+  cppOptions.diagnostics = options.diagnostics;
+  return cppOptions;
+}
+
+GenerationOptions ToRust(const trajopt::GenerationOptions& options) {
+  return GenerationOptions{
+      options.tolerance, options.maxIterations, options.timeout.count(),
+      options.mode == trajopt::GenerationMode::kFeasible, options.diagnostics};
+}
+
+HolonomicTrajectory ToRust(const TrajectoryBuffer& trajectory) {
+  size_t moduleCount = trajectory.module_count();
+  auto timestamp = trajectory.timestamp();
+  auto x = trajectory.x();
+  auto y = trajectory.y();
+  auto heading = trajectory.heading();
+  auto velocityX = trajectory.velocity_x();
+  auto velocityY = trajectory.velocity_y();
+  auto angularVelocity = trajectory.angular_velocity();
+  auto forcesX = trajectory.module_forces_x();
+  auto forcesY = trajectory.module_forces_y();
+
+  rust::Vec<HolonomicTrajectorySample> rustSamples;
+  rustSamples.reserve(trajectory.sample_count());
+  for (size_t sample = 0; sample < trajectory.sample_count(); ++sample) {
+    rust::Vec<double> fx;
+    rust::Vec<double> fy;
+    fx.reserve(moduleCount);
+    fy.reserve(moduleCount);
+    for (size_t module = 0; module < moduleCount; ++module) {
+      fx.push_back(forcesX[sample * moduleCount + module]);
+      fy.push_back(forcesY[sample * moduleCount + module]);
+    }
+
+    rustSamples.push_back(HolonomicTrajectorySample{
+        timestamp[sample], x[sample], y[sample], heading[sample],
+        velocityX[sample], velocityY[sample], angularVelocity[sample],
+        std::move(fx), std::move(fy)});
+  }
+
+  return HolonomicTrajectory{std::move(rustSamples)};
+}
+
+rust::Slice<const double> AsSlice(const std::vector<double>& column) {
+  return rust::Slice<const double>{column.data(), column.size()};
+}
+
+/// Returns every decimation-th sample of a solution, and its last sample, with
+/// the columns TrajectoryBuffer uses.
+trajopt::SwerveSolution Decimate(const trajopt::SwerveSolution& solution,
+                                 size_t decimation) {
+  trajopt::SwerveSolution decimated;
+  size_t sampleCount = solution.x.size();
+
+  double dt = 0.0;
+  for (size_t sample = 0; sample < sampleCount; ++sample) {
+    if (sample != 0) {
+      dt += solution.dt[sample - 1];
+    }
+    if (sample % decimation != 0 && sample + 1 != sampleCount) {
+      continue;
+    }
+
+    if (sample != 0) {
+      decimated.dt.push_back(dt);
+      dt = 0.0;
+    }
+    decimated.x.push_back(solution.x[sample]);
+    decimated.y.push_back(solution.y[sample]);
+    decimated.thetacos.push_back(solution.thetacos[sample]);
+    decimated.thetasin.push_back(solution.thetasin[sample]);
+    decimated.vx.push_back(solution.vx[sample]);
+    decimated.vy.push_back(solution.vy[sample]);
+    decimated.omega.push_back(solution.omega[sample]);
+    decimated.moduleFX.push_back(solution.moduleFX[sample]);
+    decimated.moduleFY.push_back(solution.moduleFY[sample]);
+  }
+
+  return decimated;
+}
+
+/// A Rust progress closure and the columns it was last sent.
+struct ProgressState {
+  explicit ProgressState(rust::Box<ProgressCallback> callback)
+      : callback{std::move(callback)} {}
+
+  // Generations from copies of the path builder may call the closure
+  // concurrently
+  std::mutex mutex;
+
+  rust::Box<ProgressCallback> callback;
+
+  /// The handle of the generation the columns were sent for.
+  int64_t sentHandle = 0;
+  std::optional<TrajectoryBuffer> sent;
+};
+
+/// The pool every asynchronous generation shares.
+trajopt::GenerationPool& SharedGenerationPool() {
+  static trajopt::GenerationPool pool;
+  return pool;
+}
+
+}  // namespace
+
+TrajectoryBuffer::TrajectoryBuffer(trajopt::SwerveSolution sol)
+    : solution{std::move(sol)} {
+  size_t sampleCount = solution.x.size();
+  samples = sampleCount;
+  if (sampleCount > 0) {
+    modules = solution.moduleFX[0].size();
+  }
+
+  timestamps.reserve(sampleCount);
+  headings.resize(sampleCount);
+  trajopt::BatchRadians(solution.thetacos, solution.thetasin, headings);
+  forces_x.reserve(sampleCount * modules);
+  forces_y.reserve(sampleCount * modules);
+
+  double timestamp = 0.0;
+  for (size_t sample = 0; sample < sampleCount; ++sample) {
+    if (sample != 0) {
+      timestamp += solution.dt[sample - 1];
+    }
+    timestamps.push_back(timestamp);
+    forces_x.insert(forces_x.end(), solution.moduleFX[sample].begin(),
+                    solution.moduleFX[sample].end());
+    forces_y.insert(forces_y.end(), solution.moduleFY[sample].begin(),
+                    solution.moduleFY[sample].end());
+  }
+}
+
+size_t TrajectoryBuffer::sample_count() const {
+  return samples;
+}
+
+size_t TrajectoryBuffer::module_count() const {
+  return modules;
+}
+
+uint32_t TrajectoryBuffer::changed_columns() const {
+  return changed;
+}
+
+rust::Slice<const double> TrajectoryBuffer::timestamp() const {
+  return AsSlice(timestamps);
+}
+
+rust::Slice<const double> TrajectoryBuffer::x() const {
+  return AsSlice(solution.x);
+}
+
+rust::Slice<const double> TrajectoryBuffer::y() const {
+  return AsSlice(solution.y);
+}
+
+rust::Slice<const double> TrajectoryBuffer::heading() const {
+  return AsSlice(headings);
+}
+
+rust::Slice<const double> TrajectoryBuffer::velocity_x() const {
+  return AsSlice(solution.vx);
+}
+
+rust::Slice<const double> TrajectoryBuffer::velocity_y() const {
+  return AsSlice(solution.vy);
+}
+
+rust::Slice<const double> TrajectoryBuffer::angular_velocity() const {
+  return AsSlice(solution.omega);
+}
+
+rust::Slice<const double> TrajectoryBuffer::module_forces_x() const {
+  return AsSlice(forces_x);
+}
+
+rust::Slice<const double> TrajectoryBuffer::module_forces_y() const {
+  return AsSlice(forces_y);
+}
+
+void TrajectoryBuffer::KeepChanged(TrajectoryBuffer& sent, double tolerance) {
+  changed = 0;
+  for (size_t column = 0; column < kColumnCount; ++column) {
+    auto& values = Column(column);
+    auto& sentValues = sent.Column(column);
+
+    bool unchanged =
+        values.size() == sentValues.size() &&
+        std::equal(values.begin(), values.end(), sentValues.begin(),
+                   [&](double value, double sentValue) {
+                     return std::abs(value - sentValue) <= tolerance;
+                   });
+    if (unchanged) {
+      values.clear();
+    } else {
+      sentValues = values;
+      changed |= 1u << column;
+    }
+  }
+}
+
+std::vector<double>& TrajectoryBuffer::Column(size_t column) {
+  switch (column) {
+    case 0:
+      return timestamps;
+    case 1:
+      return solution.x;
+    case 2:
+      return solution.y;
+    case 3:
+      return headings;
+    case 4:
+      return solution.vx;
+    case 5:
+      return solution.vy;
+    case 6:
+      return solution.omega;
+    case 7:
+      return forces_x;
+    default:
+      return forces_y;
+  }
+}
+
+GenerationJob::GenerationJob(std::shared_ptr<trajopt::GenerationJob> job)
+    : job{std::move(job)} {}
+
+bool GenerationJob::is_done() const {
+  return job->IsDone();
+}
+
+void GenerationJob::cancel() const {
+  job->Cancel();
+}
+
+std::unique_ptr<TrajectoryBuffer> GenerationJob::progress() const {
+  if (auto progress = job->Progress(); progress.has_value()) {
+    return std::make_unique<TrajectoryBuffer>(std::move(progress.value()));
+  } else {
+    return nullptr;
+  }
+}
+
+std::unique_ptr<TrajectoryBuffer> GenerationJob::result() const {
+  if (const auto& sol = job->Wait(); sol.has_value()) {
+    return std::make_unique<TrajectoryBuffer>(sol.value());
+  } else {
+    throw std::runtime_error{sol.error()};
+  }
+}
+
+void GenerationJob::set_waker(rust::Box<JobWaker> waker) const {
+  // std::function has to be copyable, and rust::Box isn't
+  auto sharedWaker = std::make_shared<rust::Box<JobWaker>>(std::move(waker));
+  job->OnDone([sharedWaker] { (*sharedWaker)->wake(); });
+}
+
 void SwervePathBuilder::set_drivetrain(const SwerveDrivetrain& drivetrain) {
   std::vector<trajopt::SwerveModule> cppModules;
   for (const auto& module : drivetrain.modules) {
@@ -32,7 +307,7 @@ void SwervePathBuilder::set_drivetrain(const SwerveDrivetrain& drivetrain) {
                               module.wheel_max_torque});
   }
 
-  path_builder.SetDrivetrain(trajopt::SwerveDrivetrain{
+  Builder().SetDrivetrain(trajopt::SwerveDrivetrain{
       drivetrain.mass, drivetrain.moi, std::move(cppModules)});
 }
 
@@ -43,11 +318,11 @@ void SwervePathBuilder::set_control_interval_counts(
     cppCounts.emplace_back(count);
   }
 
-  path_builder.ControlIntervalCounts(std::move(cppCounts));
+  Builder().ControlIntervalCounts(std::move(cppCounts));
 }
 
 void SwervePathBuilder::set_bumpers(double length, double width) {
-  path_builder.AddBumpers(
+  Builder().AddBumpers(
       trajopt::Bumpers{.safetyDistance = 0.01,
                        .points = {{+length / 2, +width / 2},
                                   {-length / 2, +width / 2},
@@ -57,17 +332,17 @@ void SwervePathBuilder::set_bumpers(double length, double width) {
 
 void SwervePathBuilder::pose_wpt(size_t index, double x, double y,
                                  double heading) {
-  path_builder.PoseWpt(index, x, y, heading);
+  Builder().PoseWpt(index, x, y, heading);
 }
 
 void SwervePathBuilder::translation_wpt(size_t index, double x, double y,
                                         double heading_guess) {
-  path_builder.TranslationWpt(index, x, y, heading_guess);
+  Builder().TranslationWpt(index, x, y, heading_guess);
 }
 
 void SwervePathBuilder::empty_wpt(size_t index, double x_guess, double y_guess,
                                   double heading_guess) {
-  path_builder.WptInitialGuessPoint(index, {x_guess, y_guess, heading_guess});
+  Builder().WptInitialGuessPoint(index, {x_guess, y_guess, heading_guess});
 }
 
 void SwervePathBuilder::sgmt_initial_guess_points(
@@ -78,37 +353,37 @@ void SwervePathBuilder::sgmt_initial_guess_points(
                                 guess_point.heading);
   }
 
-  path_builder.SgmtInitialGuessPoints(from_index, std::move(cppGuessPoints));
+  Builder().SgmtInitialGuessPoints(from_index, std::move(cppGuessPoints));
 }
 
 void SwervePathBuilder::wpt_linear_velocity_direction(size_t index,
                                                       double angle) {
-  path_builder.WptConstraint(index,
-                             trajopt::LinearVelocityDirectionConstraint{angle});
+  Builder().WptConstraint(index,
+                          trajopt::LinearVelocityDirectionConstraint{angle});
 }
 
 void SwervePathBuilder::wpt_linear_velocity_max_magnitude(size_t index,
                                                           double magnitude) {
-  path_builder.WptConstraint(
+  Builder().WptConstraint(
       index, trajopt::LinearVelocityMaxMagnitudeConstraint{magnitude});
 }
 
 void SwervePathBuilder::wpt_angular_velocity_max_magnitude(
     size_t index, double angular_velocity) {
-  path_builder.WptConstraint(
+  Builder().WptConstraint(
       index, trajopt::AngularVelocityMaxMagnitudeConstraint{angular_velocity});
 }
 
 void SwervePathBuilder::wpt_linear_acceleration_max_magnitude(
     size_t index, double magnitude) {
-  path_builder.WptConstraint(
+  Builder().WptConstraint(
       index, trajopt::LinearAccelerationMaxMagnitudeConstraint{magnitude});
 }
 
 void SwervePathBuilder::wpt_point_at(size_t index, double field_point_x,
                                      double field_point_y,
                                      double heading_tolerance) {
-  path_builder.WptConstraint(
+  Builder().WptConstraint(
       index, trajopt::PointAtConstraint{
                  trajopt::Translation2d{field_point_x, field_point_y},
                  heading_tolerance});
@@ -117,28 +392,28 @@ void SwervePathBuilder::wpt_point_at(size_t index, double field_point_x,
 void SwervePathBuilder::sgmt_linear_velocity_direction(size_t from_index,
                                                        size_t to_index,
                                                        double angle) {
-  path_builder.SgmtConstraint(
+  Builder().SgmtConstraint(
       from_index, to_index, trajopt::LinearVelocityDirectionConstraint{angle});
 }
 
 void SwervePathBuilder::sgmt_linear_velocity_max_magnitude(size_t from_index,
                                                            size_t to_index,
                                                            double magnitude) {
-  path_builder.SgmtConstraint(
+  Builder().SgmtConstraint(
       from_index, to_index,
       trajopt::LinearVelocityMaxMagnitudeConstraint{magnitude});
 }
 
 void SwervePathBuilder::sgmt_angular_velocity_max_magnitude(
     size_t from_index, size_t to_index, double angular_velocity) {
-  path_builder.SgmtConstraint(
+  Builder().SgmtConstraint(
       from_index, to_index,
       trajopt::AngularVelocityMaxMagnitudeConstraint{angular_velocity});
 }
 
 void SwervePathBuilder::sgmt_linear_acceleration_max_magnitude(
     size_t from_index, size_t to_index, double magnitude) {
-  path_builder.SgmtConstraint(
+  Builder().SgmtConstraint(
       from_index, to_index,
       trajopt::LinearAccelerationMaxMagnitudeConstraint{magnitude});
 }
@@ -147,7 +422,7 @@ void SwervePathBuilder::sgmt_point_at(size_t from_index, size_t to_index,
                                       double field_point_x,
                                       double field_point_y,
                                       double heading_tolerance) {
-  path_builder.SgmtConstraint(
+  Builder().SgmtConstraint(
       from_index, to_index,
       trajopt::PointAtConstraint{{field_point_x, field_point_y},
                                  heading_tolerance});
@@ -156,7 +431,7 @@ void SwervePathBuilder::sgmt_point_at(size_t from_index, size_t to_index,
 void SwervePathBuilder::sgmt_circle_obstacle(size_t from_index, size_t to_index,
                                              double x, double y,
                                              double radius) {
-  path_builder.SgmtObstacle(from_index, to_index, {radius, {{x, y}}});
+  Builder().SgmtObstacle(from_index, to_index, {radius, {{x, y}}});
 }
 
 void SwervePathBuilder::sgmt_polygon_obstacle(size_t from_index,
@@ -173,39 +448,27 @@ void SwervePathBuilder::sgmt_polygon_obstacle(size_t from_index,
     cppPoints.emplace_back(x.at(i), y.at(i));
   }
 
-  path_builder.SgmtObstacle(from_index, to_index,
-                            trajopt::Obstacle{.safetyDistance = radius,
-                                              .points = std::move(cppPoints)});
+  Builder().SgmtObstacle(from_index, to_index,
+                         trajopt::Obstacle{.safetyDistance = radius,
+                                           .points = std::move(cppPoints)});
 }
 
-HolonomicTrajectory SwervePathBuilder::generate(bool diagnostics,
-                                                int64_t handle) const {
-  trajopt::SwerveTrajectoryGenerator generator{path_builder, handle};
-  if (auto sol = generator.Generate(diagnostics); sol.has_value()) {
-    trajopt::HolonomicTrajectory cppTrajectory{sol.value()};
-
-    rust::Vec<HolonomicTrajectorySample> rustSamples;
-    for (const auto& cppSample : cppTrajectory.samples) {
-      rust::Vec<double> fx;
-      std::copy(cppSample.moduleForcesX.begin(), cppSample.moduleForcesX.end(),
-                std::back_inserter(fx));
-
-      rust::Vec<double> fy;
-      std::copy(cppSample.moduleForcesY.begin(), cppSample.moduleForcesY.end(),
-                std::back_inserter(fy));
-
-      rustSamples.push_back(HolonomicTrajectorySample{
-          cppSample.timestamp, cppSample.x, cppSample.y, cppSample.heading,
-          cppSample.velocityX, cppSample.velocityY, cppSample.angularVelocity,
-          std::move(fx), std::move(fy)});
-    }
-
-    return HolonomicTrajectory{std::move(rustSamples)};
+std::unique_ptr<TrajectoryBuffer> SwervePathBuilder::generate_trajectory(
+    const GenerationOptions& options, int64_t handle) const {
+  trajopt::SwerveTrajectoryGenerator generator{Spec(), handle};
+  if (auto sol = generator.Generate(ToCpp(options)); sol.has_value()) {
+    return std::make_unique<TrajectoryBuffer>(std::move(sol.value()));
   } else {
     throw std::runtime_error{sol.error()};
   }
 }
 
+std::unique_ptr<GenerationJob> SwervePathBuilder::generate_async(
+    const GenerationOptions& options, int64_t handle) const {
+  return std::make_unique<GenerationJob>(
+      SharedGenerationPool().Submit(Spec(), ToCpp(options), handle));
+}
+
 /**
  * Add a callback that will be called on each iteration of the solver.
  *
@@ -217,36 +480,100 @@ HolonomicTrajectory SwervePathBuilder::generate(bool diagnostics,
  */
 void SwervePathBuilder::add_progress_callback(
     rust::Fn<void(HolonomicTrajectory, int64_t)> callback) {
-  path_builder.AddIntermediateCallback(
+  Builder().AddIntermediateCallback(
       [=](trajopt::SwerveSolution& solution, int64_t handle) {
-        trajopt::HolonomicTrajectory cppTrajectory{solution};
-
-        rust::Vec<HolonomicTrajectorySample> rustSamples;
-        for (const auto& cppSample : cppTrajectory.samples) {
-          rust::Vec<double> fx;
-          std::copy(cppSample.moduleForcesX.begin(),
-                    cppSample.moduleForcesX.end(), std::back_inserter(fx));
-
-          rust::Vec<double> fy;
-          std::copy(cppSample.moduleForcesY.begin(),
-                    cppSample.moduleForcesY.end(), std::back_inserter(fy));
-
-          rustSamples.push_back(HolonomicTrajectorySample{
-              cppSample.timestamp, cppSample.x, cppSample.y, cppSample.heading,
-              cppSample.velocityX, cppSample.velocityY,
-              cppSample.angularVelocity, std::move(fx), std::move(fy)});
-        }
+        callback(ToRust(TrajectoryBuffer{solution}), handle);
+      });
+}
 
-        callback(HolonomicTrajectory{rustSamples}, handle);
+/**
+ * Add a callback that will be called on each iteration of the solver with the
+ * trajectory's column buffers, which are only valid during the call.
+ *
+ * @param callback: a `fn` (not a closure) to be executed. The callback's
+ * first parameter will be a `trajopt::TrajectoryBuffer`, and the second
+ * parameter will be an `i64` equal to the handle passed in `generate()`
+ *
+ * This function can be called multiple times to add multiple callbacks.
+ */
+void SwervePathBuilder::add_trajectory_callback(
+    rust::Fn<void(const TrajectoryBuffer&, int64_t)> callback) {
+  Builder().AddIntermediateCallback(
+      [=](trajopt::SwerveSolution& solution, int64_t handle) {
+        callback(TrajectoryBuffer{solution}, handle);
+      });
+}
+
+/**
+ * Add a closure that will be called on each iteration of the solver, at most
+ * as often as the callback rate allows.
+ *
+ * @param callback: the closure. Its first parameter will be a
+ * `trajopt::TrajectoryBuffer` that's only valid during the call, and the second
+ * parameter will be an `i64` equal to the handle passed in `generate()`
+ * @param options: how much of each trajectory to send. With deltas, the
+ * columns are compared against those last sent for the same handle.
+ *
+ * This function can be called multiple times to add multiple callbacks.
+ */
+void SwervePathBuilder::add_progress_closure(
+    rust::Box<ProgressCallback> callback, const ProgressOptions& options) {
+  auto state = std::make_shared<ProgressState>(std::move(callback));
+  Builder().AddIntermediateCallback(
+      [state, decimation = std::max<size_t>(options.decimation, 1),
+       deltas = options.deltas, tolerance = options.delta_tolerance](
+          trajopt::SwerveSolution& solution, int64_t handle) {
+        TrajectoryBuffer trajectory{decimation > 1
+                                        ? Decimate(solution, decimation)
+                                        : solution};
+
+        std::scoped_lock lock{state->mutex};
+        if (deltas) {
+          if (!state->sent || state->sentHandle != handle) {
+            state->sent.emplace(trajopt::SwerveSolution{});
+            state->sentHandle = handle;
+          }
+          trajectory.KeepChanged(*state->sent, tolerance);
+        }
+        state->callback->call(trajectory, handle);
       });
 }
 
+void SwervePathBuilder::set_callback_rate(double rate) {
+  Builder().SetCallbackRate(rate);
+}
+
+trajopt::SwervePathBuilder& SwervePathBuilder::Builder() {
+  spec.reset();
+  return path_builder;
+}
+
+const std::shared_ptr<const trajopt::SwervePathSpec>& SwervePathBuilder::Spec()
+    const {
+  if (!spec) {
+    spec = std::make_shared<const trajopt::SwervePathSpec>(path_builder);
+  }
+  return spec;
+}
+
 std::unique_ptr<SwervePathBuilder> swerve_path_builder_new() {
   return std::make_unique<SwervePathBuilder>();
 }
 
+GenerationOptions default_generation_options() {
+  return ToRust(trajopt::GenerationOptions{});
+}
+
+GenerationOptions preview_generation_options() {
+  return ToRust(trajopt::GenerationOptions::Preview());
+}
+
+GenerationOptions export_generation_options() {
+  return ToRust(trajopt::GenerationOptions::Export());
+}
+
 void cancel_all() {
-  trajopt::GetCancellationFlag() = 1;
+  ++trajopt::GetCancellationFlag();
 }
 
 }  // namespace trajopt::rsffi
@@ -2,19 +2,104 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <rust/cxx.h>
 
+#include "trajopt/GenerationPool.hpp"
 #include "trajopt/path/SwervePathBuilder.hpp"
+#include "trajopt/path/SwervePathSpec.hpp"
+#include "trajopt/solution/SwerveSolution.hpp"
 
 namespace trajopt::rsffi {
 
+struct GenerationOptions;
 struct HolonomicTrajectory;
+struct JobWaker;
 struct Pose2d;
+struct ProgressCallback;
+struct ProgressOptions;
 struct SwerveDrivetrain;
 
+/**
+ * A trajectory stored as one contiguous buffer per column, which Rust borrows
+ * as slices without copying.
+ */
+class TrajectoryBuffer {
+ public:
+  /// Bit i of changed_columns() is set if column i is present, in the order of
+  /// the column accessors below.
+  static constexpr size_t kColumnCount = 9;
+
+  explicit TrajectoryBuffer(trajopt::SwerveSolution sol);
+
+  size_t sample_count() const;
+  size_t module_count() const;
+  uint32_t changed_columns() const;
+
+  rust::Slice<const double> timestamp() const;
+  rust::Slice<const double> x() const;
+  rust::Slice<const double> y() const;
+  rust::Slice<const double> heading() const;
+  rust::Slice<const double> velocity_x() const;
+  rust::Slice<const double> velocity_y() const;
+  rust::Slice<const double> angular_velocity() const;
+
+  // Module forces are sample-major, with module_count() forces per sample
+  rust::Slice<const double> module_forces_x() const;
+  rust::Slice<const double> module_forces_y() const;
+
+  /**
+   * Turns this buffer into a delta against the columns last sent, by emptying
+   * the columns that are within tolerance of them. The columns that are kept
+   * replace the sent ones.
+   *
+   * @param sent The columns last sent.
+   * @param tolerance The largest change of any value in an unchanged column.
+   */
+  void KeepChanged(TrajectoryBuffer& sent, double tolerance);
+
+ private:
+  // The position and velocity columns are the solution's own
+  trajopt::SwerveSolution solution;
+
+  std::vector<double> timestamps;
+  std::vector<double> headings;
+  std::vector<double> forces_x;
+  std::vector<double> forces_y;
+  size_t samples = 0;
+  size_t modules = 0;
+  uint32_t changed = (1u << kColumnCount) - 1;
+
+  std::vector<double>& Column(size_t column);
+};
+
+/**
+ * A trajectory generation running on the shared worker pool.
+ */
+class GenerationJob {
+ public:
+  explicit GenerationJob(std::shared_ptr<trajopt::GenerationJob> job);
+
+  bool is_done() const;
+  void cancel() const;
+
+  // Returns nullptr if the solver hasn't reported any progress yet
+  std::unique_ptr<TrajectoryBuffer> progress() const;
+
+  // Blocks until the generation has finished
+  std::unique_ptr<TrajectoryBuffer> result() const;
+
+  void set_waker(rust::Box<JobWaker> waker) const;
+
+ private:
+  std::shared_ptr<trajopt::GenerationJob> job;
+};
+
 class SwervePathBuilder {
  public:
   SwervePathBuilder() = default;
@@ -57,20 +142,41 @@ class SwervePathBuilder {
                              rust::Vec<double> x, rust::Vec<double> y,
                              double radius);
 
-  // TODO: Return std::expected<HolonomicTrajectory, std::string> instead of
+  // TODO: Return std::expected<TrajectoryBuffer, std::string> instead of
   // throwing exception, once cxx supports it
-  HolonomicTrajectory generate(bool diagnostics = false,
-                               int64_t handle = 0) const;
+  std::unique_ptr<TrajectoryBuffer> generate_trajectory(
+      const GenerationOptions& options, int64_t handle = 0) const;
+  std::unique_ptr<GenerationJob> generate_async(
+      const GenerationOptions& options, int64_t handle = 0) const;
 
   void add_progress_callback(
       rust::Fn<void(HolonomicTrajectory, int64_t)> callback);
+  void add_trajectory_callback(
+      rust::Fn<void(const TrajectoryBuffer&, int64_t)> callback);
+  void add_progress_closure(rust::Box<ProgressCallback> callback,
+                            const ProgressOptions& options);
+  void set_callback_rate(double rate);
 
  private:
   trajopt::SwervePathBuilder path_builder;
+
+  /// Snapshot of the path builder shared by its generations, or nullptr if
+  /// it's been modified since the last one
+  mutable std::shared_ptr<const trajopt::SwervePathSpec> spec;
+
+  /// Returns the path builder for modification.
+  trajopt::SwervePathBuilder& Builder();
+
+  /// Returns the snapshot of the path builder, taking it if there isn't one.
+  const std::shared_ptr<const trajopt::SwervePathSpec>& Spec() const;
 };
 
 std::unique_ptr<SwervePathBuilder> swerve_path_builder_new();
 
+GenerationOptions default_generation_options();
+GenerationOptions preview_generation_options();
+GenerationOptions export_generation_options();
+
 void cancel_all();
 
 }  // namespace trajopt::rsffi
@@ -6,48 +6,122 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include <sleipnir/optimization/OptimizationProblem.hpp>
 
+#include "trajopt/DecomposedSwerveTrajectoryGenerator.hpp"
+#include "trajopt/constraint/Constraint.hpp"
+#include "trajopt/constraint/detail/FieldGeometryCache.hpp"
+#include "trajopt/drivetrain/detail/SwerveDynamics.hpp"
+#include "trajopt/objective/Objective.hpp"
+#include "trajopt/obstacle/FieldModel.hpp"
+#include "trajopt/obstacle/detail/ObstacleConstraints.hpp"
 #include "trajopt/path/SwervePathBuilder.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
 #include "trajopt/util/Cancellation.hpp"
 #include "trajopt/util/TrajoptUtil.hpp"
+#include "trajopt/util/ValidateTrajectory.hpp"
+#include "trajopt/util/detail/CallbackReporter.hpp"
 
 namespace trajopt {
 
-inline std::vector<double> RowSolutionValue(
-    std::vector<sleipnir::Variable>& rowVector) {
-  std::vector<double> valueRowVector;
-  valueRowVector.reserve(rowVector.size());
-  for (auto& expression : rowVector) {
-    valueRowVector.push_back(expression.Value());
+// These overwrite the values in place, so a reused solution doesn't allocate
+
+inline void RowSolutionValue(std::vector<sleipnir::Variable>& rowVector,
+                             std::vector<double>& valueRowVector) {
+  valueRowVector.resize(rowVector.size());
+  for (size_t i = 0; i < rowVector.size(); ++i) {
+    valueRowVector[i] = rowVector[i].Value();
   }
-  return valueRowVector;
 }
 
-inline std::vector<std::vector<double>> MatrixSolutionValue(
-    std::vector<std::vector<sleipnir::Variable>>& matrix) {
-  std::vector<std::vector<double>> valueMatrix;
-  valueMatrix.reserve(matrix.size());
-  for (auto& row : matrix) {
-    valueMatrix.push_back(RowSolutionValue(row));
+inline void MatrixSolutionValue(std::vector<sleipnir::Variable>& matrix,
+                                size_t columnCount,
+                                std::vector<std::vector<double>>& valueMatrix) {
+  size_t rowCount = columnCount == 0 ? 0 : matrix.size() / columnCount;
+  valueMatrix.resize(rowCount);
+  for (size_t row = 0; row < rowCount; ++row) {
+    valueMatrix[row].resize(columnCount);
+    for (size_t column = 0; column < columnCount; ++column) {
+      valueMatrix[row][column] = matrix[row * columnCount + column].Value();
+    }
   }
-  return valueMatrix;
 }
 
 SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     SwervePathBuilder pathBuilder, int64_t handle)
-    : path(pathBuilder.GetPath()), N(pathBuilder.GetControlIntervalCounts()) {
-  auto initialGuess = pathBuilder.CalculateInitialGuess();
+    : SwerveTrajectoryGenerator(
+          std::make_shared<const SwervePathSpec>(std::move(pathBuilder)),
+          handle) {}
+
+SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
+    std::shared_ptr<const SwervePathSpec> spec, int64_t handle)
+    : SwerveTrajectoryGenerator(spec, spec->GetInitialGuess(), handle, true) {}
+
+SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
+    SwervePathBuilder pathBuilder, const SwerveSolution& initialGuess,
+    int64_t handle)
+    : SwerveTrajectoryGenerator(
+          std::make_shared<const SwervePathSpec>(std::move(pathBuilder)),
+          initialGuess, handle, true) {}
+
+SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
+    std::shared_ptr<const SwervePathSpec> spec,
+    const SwerveSolution& initialGuess, int64_t handle)
+    : SwerveTrajectoryGenerator(std::move(spec), initialGuess, handle, true) {}
+
+SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
+    std::shared_ptr<const SwervePathSpec> pathSpec,
+    const SwerveSolution& initialGuess, int64_t handle,
+    bool splitAtPinnedWaypoints)
+    : spec{std::move(pathSpec)},
+      path{spec->GetPath()},
+      intermediateCallbacks{path.callbacks},
+      N(spec->GetControlIntervalCounts()),
+      handle{handle} {
+  // Total time constraints couple every segment, and the jerk penalty couples
+  // the segments on either side of each waypoint
+  if (splitAtPinnedWaypoints && !path.totalTime && !path.maxTotalTime &&
+      !std::holds_alternative<TimeAndJerkObjective>(path.objective)) {
+    std::vector<size_t> pinnedWaypoints;
+    for (size_t wptIndex = 1; wptIndex + 1 < path.waypoints.size();
+         ++wptIndex) {
+      if (IsWaypointPinned(path, wptIndex)) {
+        pinnedWaypoints.push_back(wptIndex);
+      }
+    }
+
+    // The pieces build their own problems, so this one stays empty
+    if (!pinnedWaypoints.empty()) {
+      decomposed = std::make_unique<DecomposedSwerveTrajectoryGenerator>(
+          spec, initialGuess, std::move(pinnedWaypoints),
+          DecompositionOptions{}, handle);
+      return;
+    }
+  }
 
-  callbacks.emplace_back([this, handle = handle] {
-    constexpr int fps = 60;
-    constexpr std::chrono::duration<double> timePerFrame{1.0 / fps};
+  // Each generator limits its own updates, so concurrent generators don't
+  // starve each other
+  std::chrono::steady_clock::time_point lastFrameTime;
+  callbacks.emplace_back([this, lastFrameTime]() mutable {
+    if (intermediateCallbacks.empty()) {
+      return;
+    }
+
+    std::chrono::duration<double> timePerFrame{1.0 / path.callbackRate};
 
     // FPS limit on sending updates
-    static auto lastFrameTime = std::chrono::steady_clock::now();
     auto now = std::chrono::steady_clock::now();
     if (now - lastFrameTime < timePerFrame) {
       return;
@@ -55,15 +129,23 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
 
     lastFrameTime = now;
 
+    if (reporter) {
+      ConstructSwerveSolution(reporter->Slot());
+      reporter->Publish();
+      return;
+    }
+
     auto soln = ConstructSwerveSolution();
-    for (auto& callback : this->path.callbacks) {
-      callback(soln, handle);
+    for (auto& callback : intermediateCallbacks) {
+      callback(soln, this->handle);
     }
+    ++callbackCounters.delivered;
   });
   size_t wptCnt = 1 + N.size();
   size_t sgmtCnt = N.size();
   size_t sampTot = GetIndex(N, wptCnt, 0);
   size_t moduleCnt = path.drivetrain.modules.size();
+  bool reduced = path.transcription == Transcription::kReduced;
 
   x.reserve(sampTot);
   y.reserve(sampTot);
@@ -76,14 +158,8 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
   ay.reserve(sampTot);
   alpha.reserve(sampTot);
 
-  Fx.reserve(sampTot);
-  Fy.reserve(sampTot);
-  for (size_t sampIndex = 0; sampIndex < sampTot; ++sampIndex) {
-    auto& _Fx = Fx.emplace_back();
-    auto& _Fy = Fy.emplace_back();
-    _Fx.reserve(moduleCnt);
-    _Fy.reserve(moduleCnt);
-  }
+  Fx.reserve(sampTot * moduleCnt);
+  Fy.reserve(sampTot * moduleCnt);
 
   dt.reserve(sgmtCnt);
 
@@ -95,32 +171,22 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     vx.emplace_back(problem.DecisionVariable());
     vy.emplace_back(problem.DecisionVariable());
     omega.emplace_back(problem.DecisionVariable());
-    ax.emplace_back(problem.DecisionVariable());
-    ay.emplace_back(problem.DecisionVariable());
-    alpha.emplace_back(problem.DecisionVariable());
 
-    for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
-      Fx.at(index).emplace_back(problem.DecisionVariable());
-      Fy.at(index).emplace_back(problem.DecisionVariable());
+    // The reduced transcription defines the accelerations by the dynamics
+    if (!reduced) {
+      ax.emplace_back(problem.DecisionVariable());
+      ay.emplace_back(problem.DecisionVariable());
+      alpha.emplace_back(problem.DecisionVariable());
     }
-  }
 
-  double minWidth = INFINITY;
-  for (size_t i = 1; i < path.drivetrain.modules.size(); i++) {
-    if (std::abs(path.drivetrain.modules.at(i - 1).translation.X() -
-                 path.drivetrain.modules.at(i).translation.X()) != 0) {
-      minWidth = std::min(
-          minWidth, std::abs(path.drivetrain.modules.at(i - 1).translation.X() -
-                             path.drivetrain.modules.at(i).translation.X()));
-    }
-    if (std::abs(path.drivetrain.modules.at(i - 1).translation.Y() -
-                 path.drivetrain.modules.at(i).translation.Y()) != 0) {
-      minWidth = std::min(
-          minWidth, std::abs(path.drivetrain.modules.at(i - 1).translation.Y() -
-                             path.drivetrain.modules.at(i).translation.Y()));
+    for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
+      Fx.emplace_back(problem.DecisionVariable());
+      Fy.emplace_back(problem.DecisionVariable());
     }
   }
 
+  double minWidth = detail::MinModuleSpacing(path.drivetrain);
+
   for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
     dt.emplace_back(problem.DecisionVariable());
     for (auto module : path.drivetrain.modules) {
@@ -130,18 +196,27 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     }
   }
 
-  // Minimize total time
-  sleipnir::Variable T_tot = 0;
   for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
     auto& dt_sgmt = dt.at(sgmtIndex);
     auto N_sgmt = N.at(sgmtIndex);
-    auto T_sgmt = dt_sgmt * static_cast<int>(N_sgmt);
-    T_tot += T_sgmt;
 
     problem.SubjectTo(dt_sgmt >= 0);
     dt_sgmt.SetValue(5.0 / N_sgmt);
   }
-  problem.Minimize(std::move(T_tot));
+
+  if (path.totalTime) {
+    problem.SubjectTo(TotalTime() == *path.totalTime);
+  }
+  if (path.maxTotalTime) {
+    problem.SubjectTo(TotalTime() <= *path.maxTotalTime);
+  }
+
+  // Nearly every robot has four modules
+  if (moduleCnt == 4) {
+    ApplyDynamics<4>();
+  } else {
+    ApplyDynamics<std::dynamic_extent>();
+  }
 
   // Apply kinematics constraints
   for (size_t wptIndex = 1; wptIndex < wptCnt; ++wptIndex) {
@@ -173,129 +248,262 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     }
   }
 
+  // Bumper geometry in the field frame at each sample, shared by every obstacle
+  // constraint that references the same bumper corner or edge
+  std::vector<detail::FieldGeometryCache> fieldGeometry;
+  fieldGeometry.reserve(sampTot);
   for (size_t index = 0; index < sampTot; ++index) {
-    Rotation2v theta{thetacos.at(index), thetasin.at(index)};
-    Translation2v v{vx.at(index), vy.at(index)};
-
-    // Solve for net force
-    auto Fx_net = std::accumulate(Fx.at(index).begin(), Fx.at(index).end(),
-                                  sleipnir::Variable{0.0});
-    auto Fy_net = std::accumulate(Fy.at(index).begin(), Fy.at(index).end(),
-                                  sleipnir::Variable{0.0});
+    fieldGeometry.emplace_back(Pose2v{
+        x.at(index), y.at(index), {thetacos.at(index), thetasin.at(index)}});
+  }
 
-    // Solve for net torque
-    sleipnir::Variable tau_net = 0.0;
-    for (size_t moduleIndex = 0; moduleIndex < path.drivetrain.modules.size();
-         ++moduleIndex) {
-      const auto& [translation, wheelRadius, wheelMaxAngularVelocity,
-                   wheelMaxTorque] = path.drivetrain.modules.at(moduleIndex);
+  // Applies a constraint to the samples in [startIndex, endIndex). The variant
+  // is dispatched once rather than per sample.
+  auto applyConstraint = [&](const Constraint& constraint, size_t startIndex,
+                             size_t endIndex) {
+    std::visit(
+        [&](auto&& arg) {
+          for (size_t index = startIndex; index < endIndex; ++index) {
+            auto& geometry = fieldGeometry[index];
+            if constexpr (requires { arg.Apply(problem, geometry); }) {
+              arg.Apply(problem, geometry);
+            } else {
+              Translation2v linearVelocity{vx.at(index), vy.at(index)};
+              Translation2v linearAcceleration{ax.at(index), ay.at(index)};
+              arg.Apply(problem, geometry.Pose(), linearVelocity,
+                        omega.at(index), linearAcceleration, alpha.at(index));
+            }
+          }
+        },
+        constraint);
+  };
 
-      auto r = translation.RotateBy(theta);
-      Translation2v F{Fx.at(index).at(moduleIndex),
-                      Fy.at(index).at(moduleIndex)};
+  for (size_t wptIndex = 0; wptIndex < wptCnt; ++wptIndex) {
+    // First index of next wpt - 1
+    size_t index = GetIndex(N, wptIndex + 1, 0) - 1;
 
-      tau_net += r.Cross(F);
+    for (auto& constraint : path.waypoints.at(wptIndex).waypointConstraints) {
+      applyConstraint(constraint, index, index + 1);
     }
+  }
 
-    // Apply module power constraints
-    auto vWrtRobot = v.RotateBy(-theta);
-    for (size_t moduleIndex = 0; moduleIndex < path.drivetrain.modules.size();
-         ++moduleIndex) {
-      const auto& [translation, wheelRadius, wheelMaxAngularVelocity,
-                   wheelMaxTorque] = path.drivetrain.modules.at(moduleIndex);
-
-      Translation2v vWheelWrtRobot{
-          vWrtRobot.X() - translation.Y() * omega.at(index),
-          vWrtRobot.Y() + translation.X() * omega.at(index)};
-      double maxWheelVelocity = wheelRadius * wheelMaxAngularVelocity;
-      problem.SubjectTo(vWheelWrtRobot.SquaredNorm() <=
-                        maxWheelVelocity * maxWheelVelocity);
-
-      Translation2v moduleF{Fx.at(index).at(moduleIndex),
-                            Fy.at(index).at(moduleIndex)};
-      double maxForce = wheelMaxTorque / wheelRadius;
-      problem.SubjectTo(moduleF.SquaredNorm() <= maxForce * maxForce);
+  for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
+    size_t startIndex = GetIndex(N, sgmtIndex + 1, 0);
+    size_t endIndex = GetIndex(N, sgmtIndex + 2, 0);
+    const auto& waypoint = path.waypoints.at(sgmtIndex + 1);
+
+    // Avoid the field's obstacles that come near the segment's initial guess,
+    // from the waypoint before it on
+    std::vector<Constraint> fieldConstraints;
+    if (path.field && waypoint.fieldCullDistance) {
+      size_t guessCount = endIndex - startIndex + 1;
+      detail::AppendFieldConstraints(
+          *path.field, path.bumpers, *waypoint.fieldCullDistance,
+          std::span{initialGuess.x}.subspan(startIndex - 1, guessCount),
+          std::span{initialGuess.y}.subspan(startIndex - 1, guessCount),
+          fieldConstraints);
     }
 
-    // Apply dynamics constraints
-    problem.SubjectTo(Fx_net == path.drivetrain.mass * ax.at(index));
-    problem.SubjectTo(Fy_net == path.drivetrain.mass * ay.at(index));
-    problem.SubjectTo(tau_net == path.drivetrain.moi * alpha.at(index));
-  }
-
-  for (size_t wptIndex = 0; wptIndex < wptCnt; ++wptIndex) {
-    for (auto& constraint : path.waypoints.at(wptIndex).waypointConstraints) {
-      // First index of next wpt - 1
-      size_t index = GetIndex(N, wptIndex + 1, 0) - 1;
-
-      Pose2v pose{
-          x.at(index), y.at(index), {thetacos.at(index), thetasin.at(index)}};
-      Translation2v linearVelocity{vx.at(index), vy.at(index)};
-      auto angularVelocity = omega.at(index);
-      Translation2v linearAcceleration{ax.at(index), ay.at(index)};
-      auto angularAcceleration = alpha.at(index);
-
-      std::visit(
-          [&](auto&& arg) {
-            arg.Apply(problem, pose, linearVelocity, angularVelocity,
-                      linearAcceleration, angularAcceleration);
-          },
-          constraint);
+    // Apply constraints of the same type back to back
+    std::vector<const Constraint*> constraints;
+    for (auto& constraint : waypoint.segmentConstraints) {
+      constraints.push_back(&constraint);
     }
-  }
+    for (auto& constraint : fieldConstraints) {
+      constraints.push_back(&constraint);
+    }
+    std::stable_sort(constraints.begin(), constraints.end(),
+                     [](const Constraint* lhs, const Constraint* rhs) {
+                       return lhs->index() < rhs->index();
+                     });
 
-  for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
-    for (auto& constraint :
-         path.waypoints.at(sgmtIndex + 1).segmentConstraints) {
-      size_t startIndex = GetIndex(N, sgmtIndex + 1, 0);
-      size_t endIndex = GetIndex(N, sgmtIndex + 2, 0);
-
-      for (size_t index = startIndex; index < endIndex; ++index) {
-        Pose2v pose{
-            x.at(index), y.at(index), {thetacos.at(index), thetasin.at(index)}};
-        Translation2v linearVelocity{vx.at(index), vy.at(index)};
-        auto angularVelocity = omega.at(index);
-        Translation2v linearAcceleration{ax.at(index), ay.at(index)};
-        auto angularAcceleration = alpha.at(index);
-
-        std::visit(
-            [&](auto&& arg) {
-              arg.Apply(problem, pose, linearVelocity, angularVelocity,
-                        linearAcceleration, angularAcceleration);
-            },
-            constraint);
-      }
+    for (auto constraint : constraints) {
+      applyConstraint(*constraint, startIndex, endIndex);
     }
   }
 
+  objective = BuildObjective();
+  problem.Minimize(objective);
+
   ApplyInitialGuess(initialGuess);
 }
 
+SwerveTrajectoryGenerator::~SwerveTrajectoryGenerator() = default;
+
 expected<SwerveSolution, std::string> SwerveTrajectoryGenerator::Generate(
     bool diagnostics) {
-  GetCancellationFlag() = 0;
-  problem.Callback([this](const sleipnir::SolverIterationInfo&) -> bool {
+  GenerationOptions options;
+  options.diagnostics = diagnostics;
+  return Generate(options);
+}
+
+expected<SwerveSolution, std::string> SwerveTrajectoryGenerator::Generate(
+    const GenerationOptions& options) {
+  if (decomposed) {
+    return decomposed->Generate(options);
+  }
+
+  // Set on every call so a feasibility-only solve doesn't leave the objective
+  // replaced for the next one
+  problem.Minimize(options.mode == GenerationMode::kFeasible
+                       ? sleipnir::Variable{0.0}
+                       : objective);
+
+  return Solve(options, GetCancellationFlag());
+}
+
+void SwerveTrajectoryGenerator::AddIntermediateCallback(
+    std::function<void(SwerveSolution&, int64_t)> callback) {
+  if (decomposed) {
+    decomposed->AddIntermediateCallback(std::move(callback));
+    return;
+  }
+  intermediateCallbacks.push_back(std::move(callback));
+}
+
+CallbackCounters SwerveTrajectoryGenerator::GetCallbackCounters() const {
+  if (decomposed) {
+    return decomposed->GetCallbackCounters();
+  }
+  return callbackCounters;
+}
+
+expected<SwerveSolution, std::string> SwerveTrajectoryGenerator::Solve(
+    const GenerationOptions& options, int cancellationGeneration) {
+  // Iterate so far with the lowest objective, then the lowest violation, that
+  // satisfies the constraints to within the anytime tolerance
+  std::optional<SwerveSolution> best;
+  double bestObjective = std::numeric_limits<double>::infinity();
+  double bestViolation = std::numeric_limits<double>::infinity();
+
+  int iterations = 0;
+
+  if (path.callbackThread && !intermediateCallbacks.empty()) {
+    reporter = std::make_unique<detail::CallbackReporter>(intermediateCallbacks,
+                                                          handle);
+  }
+
+  problem.Callback([&](const sleipnir::SolverIterationInfo&) -> bool {
+    ++iterations;
+
     for (auto& callback : callbacks) {
       callback();
     }
-    return trajopt::GetCancellationFlag();
+
+    if (options.anytime) {
+      auto soln = ConstructSwerveSolution();
+      double value = ObjectiveValue(soln, options.mode);
+      if (value <= bestObjective) {
+        double violation = MaxViolation(soln);
+        if (violation <= options.anytimeTolerance &&
+            (value < bestObjective || violation < bestViolation)) {
+          soln.suboptimal = true;
+          soln.constraintViolation = violation;
+          soln.iterations = iterations;
+          best = std::move(soln);
+          bestObjective = value;
+          bestViolation = violation;
+        }
+      }
+    }
+
+    return trajopt::GetCancellationFlag() != cancellationGeneration ||
+           (options.cancellation != nullptr && options.cancellation->load());
   });
 
-  // tolerance of 1e-4 is 0.1 mm
-  auto status = problem.Solve({.tolerance = 1e-4, .diagnostics = diagnostics});
+  auto status = problem.Solve({.tolerance = options.tolerance,
+                               .maxIterations = options.maxIterations,
+                               .timeout = options.timeout,
+                               .diagnostics = options.diagnostics});
+
+  // Delivers the update still pending
+  if (reporter) {
+    auto counters = reporter->Stop();
+    callbackCounters.delivered += counters.delivered;
+    callbackCounters.dropped += counters.dropped;
+    reporter.reset();
+  }
+
+  // Running out of budget isn't a failure in anytime mode if a usable iterate
+  // was found
+  using enum sleipnir::SolverExitCondition;
+  if (best && (status.exitCondition == kCallbackRequestedStop ||
+               status.exitCondition == kMaxIterationsExceeded ||
+               status.exitCondition == kTimeout)) {
+    return std::move(*best);
+  }
 
   if (static_cast<int>(status.exitCondition) < 0 ||
       status.exitCondition ==
           sleipnir::SolverExitCondition::kCallbackRequestedStop) {
     return unexpected{std::string{sleipnir::ToMessage(status.exitCondition)}};
   } else {
-    return ConstructSwerveSolution();
+    auto soln = ConstructSwerveSolution();
+    soln.iterations = iterations;
+    return soln;
+  }
+}
+
+template <size_t ModuleCount>
+void SwerveTrajectoryGenerator::ApplyDynamics() {
+  std::span<const SwerveModule, ModuleCount> modules{path.drivetrain.modules};
+
+  for (size_t index = 0; index < x.size(); ++index) {
+    Rotation2v theta{thetacos.at(index), thetasin.at(index)};
+    Translation2v v{vx.at(index), vy.at(index)};
+
+    std::span<sleipnir::Variable, ModuleCount> Fx_sample{
+        Fx.data() + ForceIndex(index, 0), modules.size()};
+    std::span<sleipnir::Variable, ModuleCount> Fy_sample{
+        Fy.data() + ForceIndex(index, 0), modules.size()};
+
+    // Solve for net force
+    auto Fx_net = std::accumulate(Fx_sample.begin(), Fx_sample.end(),
+                                  sleipnir::Variable{0.0});
+    auto Fy_net = std::accumulate(Fy_sample.begin(), Fy_sample.end(),
+                                  sleipnir::Variable{0.0});
+
+    // Solve for net torque
+    sleipnir::Variable tau_net = 0.0;
+    for (size_t moduleIndex = 0; moduleIndex < modules.size(); ++moduleIndex) {
+      Translation2v F{Fx_sample[moduleIndex], Fy_sample[moduleIndex]};
+
+      tau_net += detail::ModuleTorque(modules[moduleIndex], theta, F);
+    }
+
+    // Apply module power constraints
+    auto vWrtRobot = v.RotateBy(-theta);
+    for (size_t moduleIndex = 0; moduleIndex < modules.size(); ++moduleIndex) {
+      const auto& module = modules[moduleIndex];
+
+      auto vWheelWrtRobot =
+          detail::ModuleVelocity(module, vWrtRobot, omega.at(index));
+      double maxWheelVelocity = detail::ModuleMaxVelocity(module);
+      problem.SubjectTo(vWheelWrtRobot.SquaredNorm() <=
+                        maxWheelVelocity * maxWheelVelocity);
+
+      Translation2v moduleF{Fx_sample[moduleIndex], Fy_sample[moduleIndex]};
+      double maxForce = detail::ModuleMaxForce(module);
+      problem.SubjectTo(moduleF.SquaredNorm() <= maxForce * maxForce);
+    }
+
+    // Apply dynamics constraints, or define the accelerations by them
+    if (path.transcription == Transcription::kReduced) {
+      ax.emplace_back(Fx_net / path.drivetrain.mass);
+      ay.emplace_back(Fy_net / path.drivetrain.mass);
+      alpha.emplace_back(tau_net / path.drivetrain.moi);
+    } else {
+      problem.SubjectTo(Fx_net == path.drivetrain.mass * ax.at(index));
+      problem.SubjectTo(Fy_net == path.drivetrain.mass * ay.at(index));
+      problem.SubjectTo(tau_net == path.drivetrain.moi * alpha.at(index));
+    }
   }
 }
 
 void SwerveTrajectoryGenerator::ApplyInitialGuess(
     const SwerveSolution& solution) {
   size_t sampleTotal = x.size();
+  bool accelerationsAreVariables = path.transcription == Transcription::kFull;
   for (size_t sampleIndex = 0; sampleIndex < sampleTotal; sampleIndex++) {
     x[sampleIndex].SetValue(solution.x[sampleIndex]);
     y[sampleIndex].SetValue(solution.y[sampleIndex]);
@@ -303,12 +511,49 @@ void SwerveTrajectoryGenerator::ApplyInitialGuess(
     thetasin[sampleIndex].SetValue(solution.thetasin[sampleIndex]);
   }
 
+  // Use the guess's dynamics if it has them, since finite differences of an
+  // untimed guess are far from feasible
+  if (solution.vx.size() == sampleTotal && solution.ax.size() == sampleTotal &&
+      solution.moduleFX.size() == sampleTotal &&
+      solution.moduleFY.size() == sampleTotal) {
+    for (size_t sampleIndex = 0; sampleIndex < sampleTotal; sampleIndex++) {
+      vx[sampleIndex].SetValue(solution.vx[sampleIndex]);
+      vy[sampleIndex].SetValue(solution.vy[sampleIndex]);
+      omega[sampleIndex].SetValue(solution.omega[sampleIndex]);
+      if (accelerationsAreVariables) {
+        ax[sampleIndex].SetValue(solution.ax[sampleIndex]);
+        ay[sampleIndex].SetValue(solution.ay[sampleIndex]);
+        alpha[sampleIndex].SetValue(solution.alpha[sampleIndex]);
+      }
+
+      for (size_t moduleIndex = 0;
+           moduleIndex < path.drivetrain.modules.size(); ++moduleIndex) {
+        Fx[ForceIndex(sampleIndex, moduleIndex)].SetValue(
+            solution.moduleFX[sampleIndex][moduleIndex]);
+        Fy[ForceIndex(sampleIndex, moduleIndex)].SetValue(
+            solution.moduleFY[sampleIndex][moduleIndex]);
+      }
+    }
+
+    // Solutions from Generate() have one dt per control interval, and
+    // initial guesses have one per sample
+    size_t dtOffset = solution.dt.size() == sampleTotal ? 0 : 1;
+    for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
+      dt[sgmtIndex].SetValue(
+          solution.dt[GetIndex(N, sgmtIndex + 1, 0) - dtOffset]);
+    }
+
+    return;
+  }
+
   vx[0].SetValue(0.0);
   vy[0].SetValue(0.0);
   omega[0].SetValue(0.0);
-  ax[0].SetValue(0.0);
-  ay[0].SetValue(0.0);
-  alpha[0].SetValue(0.0);
+  if (accelerationsAreVariables) {
+    ax[0].SetValue(0.0);
+    ay[0].SetValue(0.0);
+    alpha[0].SetValue(0.0);
+  }
 
   for (size_t sampleIndex = 1; sampleIndex < sampleTotal; sampleIndex++) {
     vx[sampleIndex].SetValue(
@@ -329,6 +574,10 @@ void SwerveTrajectoryGenerator::ApplyInitialGuess(
             .Radians() /
         solution.dt[sampleIndex]);
 
+    if (!accelerationsAreVariables) {
+      continue;
+    }
+
     ax[sampleIndex].SetValue(
         (vx[sampleIndex].Value() - vx[sampleIndex - 1].Value()) /
         solution.dt[sampleIndex]);
@@ -342,29 +591,163 @@ void SwerveTrajectoryGenerator::ApplyInitialGuess(
 }
 
 SwerveSolution SwerveTrajectoryGenerator::ConstructSwerveSolution() {
-  std::vector<double> dtPerSamp;
+  SwerveSolution solution;
+  ConstructSwerveSolution(solution);
+  return solution;
+}
+
+void SwerveTrajectoryGenerator::ConstructSwerveSolution(
+    SwerveSolution& solution) {
+  solution.dt.clear();
   for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
     size_t N_sgmt = N.at(sgmtIndex);
     sleipnir::Variable dt_sgmt = dt.at(sgmtIndex);
-    double dt_val = dt_sgmt.Value();
-    for (size_t i = 0; i < N_sgmt; ++i) {
-      dtPerSamp.push_back(dt_val);
+    solution.dt.insert(solution.dt.end(), N_sgmt, dt_sgmt.Value());
+  }
+
+  RowSolutionValue(x, solution.x);
+  RowSolutionValue(y, solution.y);
+  RowSolutionValue(thetacos, solution.thetacos);
+  RowSolutionValue(thetasin, solution.thetasin);
+  RowSolutionValue(vx, solution.vx);
+  RowSolutionValue(vy, solution.vy);
+  RowSolutionValue(omega, solution.omega);
+  size_t moduleCnt = path.drivetrain.modules.size();
+  MatrixSolutionValue(Fx, moduleCnt, solution.moduleFX);
+  MatrixSolutionValue(Fy, moduleCnt, solution.moduleFY);
+
+  if (path.transcription == Transcription::kFull) {
+    RowSolutionValue(ax, solution.ax);
+    RowSolutionValue(ay, solution.ay);
+    RowSolutionValue(alpha, solution.alpha);
+  } else {
+    // The accelerations are expressions of the forces, so they're computed
+    // from the forces' values the same way
+    size_t sampleTotal = solution.x.size();
+    solution.ax.resize(sampleTotal);
+    solution.ay.resize(sampleTotal);
+    solution.alpha.resize(sampleTotal);
+    for (size_t index = 0; index < sampleTotal; ++index) {
+      Rotation2d theta{solution.thetacos[index], solution.thetasin[index]};
+      double Fx_net = 0.0;
+      double Fy_net = 0.0;
+      double tau_net = 0.0;
+      for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
+        Translation2d F{solution.moduleFX[index][moduleIndex],
+                        solution.moduleFY[index][moduleIndex]};
+        Fx_net += F.X();
+        Fy_net += F.Y();
+        tau_net += detail::ModuleTorque(path.drivetrain.modules[moduleIndex],
+                                        theta, F);
+      }
+      solution.ax[index] = Fx_net / path.drivetrain.mass;
+      solution.ay[index] = Fy_net / path.drivetrain.mass;
+      solution.alpha[index] = tau_net / path.drivetrain.moi;
     }
   }
 
-  return SwerveSolution{dtPerSamp,
-                        RowSolutionValue(x),
-                        RowSolutionValue(y),
-                        RowSolutionValue(thetacos),
-                        RowSolutionValue(thetasin),
-                        RowSolutionValue(vx),
-                        RowSolutionValue(vy),
-                        RowSolutionValue(omega),
-                        RowSolutionValue(ax),
-                        RowSolutionValue(ay),
-                        RowSolutionValue(alpha),
-                        MatrixSolutionValue(Fx),
-                        MatrixSolutionValue(Fy)};
+  solution.suboptimal = false;
+  solution.constraintViolation = 0.0;
+  solution.iterations = 0;
+}
+
+sleipnir::Variable SwerveTrajectoryGenerator::TotalTime() {
+  sleipnir::Variable T_tot = 0;
+  for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
+    T_tot += dt.at(sgmtIndex) * static_cast<int>(N.at(sgmtIndex));
+  }
+  return T_tot;
+}
+
+sleipnir::Variable SwerveTrajectoryGenerator::BuildObjective() {
+  return std::visit(
+      [&](auto&& objective) -> sleipnir::Variable {
+        using T = std::decay_t<decltype(objective)>;
+
+        if constexpr (std::same_as<T, MinimumTimeObjective>) {
+          return TotalTime();
+        } else if constexpr (std::same_as<T, MinimumForceObjective>) {
+          // Scale each module's force by its limit so modules with different
+          // limits are weighted equally
+          sleipnir::Variable J = 0;
+          for (size_t index = 0; index < x.size(); ++index) {
+            for (size_t moduleIndex = 0;
+                 moduleIndex < path.drivetrain.modules.size(); ++moduleIndex) {
+              double maxForce =
+                  detail::ModuleMaxForce(path.drivetrain.modules[moduleIndex]);
+              auto& Fx_module = Fx[ForceIndex(index, moduleIndex)];
+              auto& Fy_module = Fy[ForceIndex(index, moduleIndex)];
+              J += (Fx_module * Fx_module + Fy_module * Fy_module) /
+                   (maxForce * maxForce);
+            }
+          }
+          return J;
+        } else if constexpr (std::same_as<T, TimeAndJerkObjective>) {
+          // The first sample's acceleration is free, so changes are counted
+          // from the second sample on
+          sleipnir::Variable penalty = 0;
+          for (size_t index = 2; index < ax.size(); ++index) {
+            auto dax = ax[index] - ax[index - 1];
+            auto day = ay[index] - ay[index - 1];
+            auto dalpha = alpha[index] - alpha[index - 1];
+            penalty += dax * dax + day * day + dalpha * dalpha;
+          }
+          return TotalTime() + objective.jerkWeight * penalty;
+        }
+      },
+      path.objective);
+}
+
+double SwerveTrajectoryGenerator::ObjectiveValue(const SwerveSolution& solution,
+                                                 GenerationMode mode) const {
+  if (mode == GenerationMode::kFeasible) {
+    return 0.0;
+  }
+
+  double totalTime =
+      std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+  return std::visit(
+      [&](auto&& objective) -> double {
+        using T = std::decay_t<decltype(objective)>;
+
+        if constexpr (std::same_as<T, MinimumTimeObjective>) {
+          return totalTime;
+        } else if constexpr (std::same_as<T, MinimumForceObjective>) {
+          double J = 0.0;
+          for (size_t index = 0; index < solution.x.size(); ++index) {
+            for (size_t moduleIndex = 0;
+                 moduleIndex < path.drivetrain.modules.size(); ++moduleIndex) {
+              double maxForce =
+                  detail::ModuleMaxForce(path.drivetrain.modules[moduleIndex]);
+              double Fx_module = solution.moduleFX[index][moduleIndex];
+              double Fy_module = solution.moduleFY[index][moduleIndex];
+              J += (Fx_module * Fx_module + Fy_module * Fy_module) /
+                   (maxForce * maxForce);
+            }
+          }
+          return J;
+        } else if constexpr (std::same_as<T, TimeAndJerkObjective>) {
+          double penalty = 0.0;
+          for (size_t index = 2; index < solution.ax.size(); ++index) {
+            double dax = solution.ax[index] - solution.ax[index - 1];
+            double day = solution.ay[index] - solution.ay[index - 1];
+            double dalpha = solution.alpha[index] - solution.alpha[index - 1];
+            penalty += dax * dax + day * day + dalpha * dalpha;
+          }
+          return totalTime + objective.jerkWeight * penalty;
+        }
+      },
+      path.objective);
+}
+
+double SwerveTrajectoryGenerator::MaxViolation(
+    const SwerveSolution& solution) const {
+  auto validation = ValidateTrajectory(solution, path, N);
+  if (!validation) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  return validation->MaxViolation();
 }
 
 }  // namespace trajopt
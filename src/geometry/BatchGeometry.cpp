@@ -0,0 +1,459 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/geometry/BatchGeometry.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace trajopt {
+
+namespace {
+
+// The kernels are written once against the small vector types below, which
+// hold as many doubles as the instruction set handles at once. Elements left
+// over at the end of an array go through ScalarDouble, which computes the same
+// thing one element at a time, so results don't depend on an element's
+// position.
+
+struct ScalarMask {
+  bool m;
+
+  friend ScalarMask operator&(ScalarMask a, ScalarMask b) {
+    return {a.m && b.m};
+  }
+  friend ScalarMask operator|(ScalarMask a, ScalarMask b) {
+    return {a.m || b.m};
+  }
+  friend ScalarMask operator^(ScalarMask a, ScalarMask b) {
+    return {a.m != b.m};
+  }
+};
+
+struct ScalarDouble {
+  static constexpr size_t kWidth = 1;
+
+  double v;
+
+  ScalarDouble(double v) : v{v} {}  // NOLINT
+
+  static ScalarDouble Load(const double* data) { return *data; }
+  void Store(double* data) const { *data = v; }
+
+  friend ScalarDouble operator+(ScalarDouble a, ScalarDouble b) {
+    return a.v + b.v;
+  }
+  friend ScalarDouble operator-(ScalarDouble a, ScalarDouble b) {
+    return a.v - b.v;
+  }
+  friend ScalarDouble operator*(ScalarDouble a, ScalarDouble b) {
+    return a.v * b.v;
+  }
+  friend ScalarDouble operator/(ScalarDouble a, ScalarDouble b) {
+    return a.v / b.v;
+  }
+  friend ScalarDouble operator-(ScalarDouble a) { return -a.v; }
+
+  friend ScalarMask operator<(ScalarDouble a, ScalarDouble b) {
+    return {a.v < b.v};
+  }
+  friend ScalarMask operator>(ScalarDouble a, ScalarDouble b) {
+    return {a.v > b.v};
+  }
+  friend ScalarMask operator==(ScalarDouble a, ScalarDouble b) {
+    return {a.v == b.v};
+  }
+
+  friend ScalarDouble Min(ScalarDouble a, ScalarDouble b) {
+    return std::min(a.v, b.v);
+  }
+  friend ScalarDouble Max(ScalarDouble a, ScalarDouble b) {
+    return std::max(a.v, b.v);
+  }
+  friend ScalarDouble Abs(ScalarDouble a) { return std::abs(a.v); }
+  friend ScalarDouble Floor(ScalarDouble a) { return std::floor(a.v); }
+  friend ScalarDouble CopySign(ScalarDouble magnitude, ScalarDouble sign) {
+    return std::copysign(magnitude.v, sign.v);
+  }
+  friend ScalarDouble Select(ScalarMask mask, ScalarDouble a, ScalarDouble b) {
+    return mask.m ? a : b;
+  }
+};
+
+#if defined(__AVX2__)
+
+struct Avx2Mask {
+  __m256d m;
+
+  friend Avx2Mask operator&(Avx2Mask a, Avx2Mask b) {
+    return {_mm256_and_pd(a.m, b.m)};
+  }
+  friend Avx2Mask operator|(Avx2Mask a, Avx2Mask b) {
+    return {_mm256_or_pd(a.m, b.m)};
+  }
+  friend Avx2Mask operator^(Avx2Mask a, Avx2Mask b) {
+    return {_mm256_xor_pd(a.m, b.m)};
+  }
+};
+
+struct Avx2Double {
+  static constexpr size_t kWidth = 4;
+
+  __m256d v;
+
+  Avx2Double(__m256d v) : v{v} {}                 // NOLINT
+  Avx2Double(double v) : v{_mm256_set1_pd(v)} {}  // NOLINT
+
+  static Avx2Double Load(const double* data) { return _mm256_loadu_pd(data); }
+  void Store(double* data) const { _mm256_storeu_pd(data, v); }
+
+  friend Avx2Double operator+(Avx2Double a, Avx2Double b) {
+    return _mm256_add_pd(a.v, b.v);
+  }
+  friend Avx2Double operator-(Avx2Double a, Avx2Double b) {
+    return _mm256_sub_pd(a.v, b.v);
+  }
+  friend Avx2Double operator*(Avx2Double a, Avx2Double b) {
+    return _mm256_mul_pd(a.v, b.v);
+  }
+  friend Avx2Double operator/(Avx2Double a, Avx2Double b) {
+    return _mm256_div_pd(a.v, b.v);
+  }
+  friend Avx2Double operator-(Avx2Double a) {
+    return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0));
+  }
+
+  friend Avx2Mask operator<(Avx2Double a, Avx2Double b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)};
+  }
+  friend Avx2Mask operator>(Avx2Double a, Avx2Double b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)};
+  }
+  friend Avx2Mask operator==(Avx2Double a, Avx2Double b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)};
+  }
+
+  // The operands are swapped to match std::min() and std::max() when one is
+  // NaN
+  friend Avx2Double Min(Avx2Double a, Avx2Double b) {
+    return _mm256_min_pd(b.v, a.v);
+  }
+  friend Avx2Double Max(Avx2Double a, Avx2Double b) {
+    return _mm256_max_pd(b.v, a.v);
+  }
+  friend Avx2Double Abs(Avx2Double a) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+  }
+  friend Avx2Double Floor(Avx2Double a) { return _mm256_floor_pd(a.v); }
+  friend Avx2Double CopySign(Avx2Double magnitude, Avx2Double sign) {
+    __m256d signBit = _mm256_set1_pd(-0.0);
+    return _mm256_or_pd(_mm256_andnot_pd(signBit, magnitude.v),
+                        _mm256_and_pd(signBit, sign.v));
+  }
+  friend Avx2Double Select(Avx2Mask mask, Avx2Double a, Avx2Double b) {
+    return _mm256_blendv_pd(b.v, a.v, mask.m);
+  }
+};
+
+using NativeDouble = Avx2Double;
+constexpr std::string_view kInstructionSet = "AVX2";
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+struct NeonMask {
+  uint64x2_t m;
+
+  friend NeonMask operator&(NeonMask a, NeonMask b) {
+    return {vandq_u64(a.m, b.m)};
+  }
+  friend NeonMask operator|(NeonMask a, NeonMask b) {
+    return {vorrq_u64(a.m, b.m)};
+  }
+  friend NeonMask operator^(NeonMask a, NeonMask b) {
+    return {veorq_u64(a.m, b.m)};
+  }
+};
+
+struct NeonDouble {
+  static constexpr size_t kWidth = 2;
+
+  float64x2_t v;
+
+  NeonDouble(float64x2_t v) : v{v} {}          // NOLINT
+  NeonDouble(double v) : v{vdupq_n_f64(v)} {}  // NOLINT
+
+  static NeonDouble Load(const double* data) { return vld1q_f64(data); }
+  void Store(double* data) const { vst1q_f64(data, v); }
+
+  friend NeonDouble operator+(NeonDouble a, NeonDouble b) {
+    return vaddq_f64(a.v, b.v);
+  }
+  friend NeonDouble operator-(NeonDouble a, NeonDouble b) {
+    return vsubq_f64(a.v, b.v);
+  }
+  friend NeonDouble operator*(NeonDouble a, NeonDouble b) {
+    return vmulq_f64(a.v, b.v);
+  }
+  friend NeonDouble operator/(NeonDouble a, NeonDouble b) {
+    return vdivq_f64(a.v, b.v);
+  }
+  friend NeonDouble operator-(NeonDouble a) { return vnegq_f64(a.v); }
+
+  friend NeonMask operator<(NeonDouble a, NeonDouble b) {
+    return {vcltq_f64(a.v, b.v)};
+  }
+  friend NeonMask operator>(NeonDouble a, NeonDouble b) {
+    return {vcgtq_f64(a.v, b.v)};
+  }
+  friend NeonMask operator==(NeonDouble a, NeonDouble b) {
+    return {vceqq_f64(a.v, b.v)};
+  }
+
+  // Selected by comparison to match std::min() and std::max() when one
+  // operand is NaN
+  friend NeonDouble Min(NeonDouble a, NeonDouble b) {
+    return vbslq_f64(vcltq_f64(b.v, a.v), b.v, a.v);
+  }
+  friend NeonDouble Max(NeonDouble a, NeonDouble b) {
+    return vbslq_f64(vcltq_f64(a.v, b.v), b.v, a.v);
+  }
+  friend NeonDouble Abs(NeonDouble a) { return vabsq_f64(a.v); }
+  friend NeonDouble Floor(NeonDouble a) { return vrndmq_f64(a.v); }
+  friend NeonDouble CopySign(NeonDouble magnitude, NeonDouble sign) {
+    return vbslq_f64(vdupq_n_u64(UINT64_C(1) << 63), sign.v, magnitude.v);
+  }
+  friend NeonDouble Select(NeonMask mask, NeonDouble a, NeonDouble b) {
+    return vbslq_f64(mask.m, a.v, b.v);
+  }
+};
+
+using NativeDouble = NeonDouble;
+constexpr std::string_view kInstructionSet = "NEON";
+
+#else
+
+using NativeDouble = ScalarDouble;
+constexpr std::string_view kInstructionSet = "scalar";
+
+#endif
+
+/**
+ * Calls kernel.template operator()<V>(index) for blocks of elements starting
+ * at index, where V is the vector type holding the block.
+ *
+ * @param count The number of elements.
+ * @param kernel The kernel.
+ */
+template <typename Kernel>
+void ForEachBlock(size_t count, Kernel&& kernel) {
+  size_t index = 0;
+  for (; index + NativeDouble::kWidth <= count;
+       index += NativeDouble::kWidth) {
+    kernel.template operator()<NativeDouble>(index);
+  }
+  for (; index < count; ++index) {
+    kernel.template operator()<ScalarDouble>(index);
+  }
+}
+
+template <typename V>
+auto SignBit(V value) {
+  return CopySign(1.0, value) < 0.0;
+}
+
+/**
+ * Returns atan2(y, x).
+ *
+ * The arctangent of the smaller of |x| and |y| over the larger uses the
+ * rational approximation from the Cephes math library.
+ */
+template <typename V>
+V Atan2(V y, V x) {
+  constexpr double kReductionThreshold = 0.66;
+  constexpr double kMoreBits = 6.123233995736765886130e-17;
+
+  constexpr double P0 = -8.750608600031904122785e-1;
+  constexpr double P1 = -1.615753718733365076637e1;
+  constexpr double P2 = -7.500855792314704667340e1;
+  constexpr double P3 = -1.228866684490136173410e2;
+  constexpr double P4 = -6.485021904942025371773e1;
+  constexpr double Q0 = 2.485846490142306297962e1;
+  constexpr double Q1 = 1.650270098316988542046e2;
+  constexpr double Q2 = 4.328810604912902668951e2;
+  constexpr double Q3 = 4.853903996359136964868e2;
+  constexpr double Q4 = 1.945506571482613964425e2;
+
+  V absX = Abs(x);
+  V absY = Abs(y);
+  auto steep = absY > absX;
+  V larger = Max(absX, absY);
+  V t = Select(larger > 0.0, Min(absX, absY) / larger, 0.0);
+
+  // The ratio is at most one, so reducing it to [-0.21, 0.66] with
+  // atan(t) = π/4 + atan((t - 1) / (t + 1)) is enough
+  auto reduce = t > kReductionThreshold;
+  V z = Select(reduce, (t - 1.0) / (t + 1.0), t);
+  V offset = Select(reduce, V{std::numbers::pi / 4.0}, V{0.0});
+  V moreBits = Select(reduce, V{0.5 * kMoreBits}, V{0.0});
+
+  V zz = z * z;
+  V p = (((P0 * zz + P1) * zz + P2) * zz + P3) * zz + P4;
+  V q = ((((zz + Q0) * zz + Q1) * zz + Q2) * zz + Q3) * zz + Q4;
+  V angle = offset + ((z * (zz * p / q) + z) + moreBits);
+
+  angle = Select(steep, std::numbers::pi / 2.0 - angle, angle);
+  angle = Select(SignBit(x), std::numbers::pi - angle, angle);
+  return CopySign(angle, y);
+}
+
+/**
+ * Computes cos(angle) and sin(angle).
+ *
+ * The angle is reduced to [-π/4, π/4] with the extended precision value of
+ * π/4 and the polynomials from the Cephes math library.
+ */
+template <typename V>
+void CosSin(V angle, V& cos, V& sin) {
+  constexpr double kFourOverPi = 1.27323954473516268615;
+  constexpr double DP1 = 7.85398125648498535156e-1;
+  constexpr double DP2 = 3.77489470793079817668e-8;
+  constexpr double DP3 = 2.69515142907905952645e-15;
+
+  constexpr double S0 = 1.58962301576546568060e-10;
+  constexpr double S1 = -2.50507477628578072866e-8;
+  constexpr double S2 = 2.75573136213857245213e-6;
+  constexpr double S3 = -1.98412698295895385996e-4;
+  constexpr double S4 = 8.33333333332211858878e-3;
+  constexpr double S5 = -1.66666666666666307295e-1;
+  constexpr double C0 = -1.13585365213876817300e-11;
+  constexpr double C1 = 2.08757008419747316778e-9;
+  constexpr double C2 = -2.75573141792967388112e-7;
+  constexpr double C3 = 2.48015872888517045348e-5;
+  constexpr double C4 = -1.38888888888730564116e-3;
+  constexpr double C5 = 4.16666666666665929218e-2;
+
+  V x = Abs(angle);
+
+  // The octant, rounded up to an even one so the reduced angle is centered on
+  // a multiple of π/4
+  V octant = Floor(x * kFourOverPi);
+  octant = octant + (octant - 2.0 * Floor(octant * 0.5));
+  V j = octant - 8.0 * Floor(octant * 0.125);
+
+  // Octants 4 through 7 negate both results, and octants 2 and 6 swap them
+  auto secondHalf = j > 3.0;
+  auto swap = (j == 2.0) | (j == 6.0);
+
+  V z = ((x - octant * DP1) - octant * DP2) - octant * DP3;
+  V zz = z * z;
+  V sinPoly =
+      z +
+      z * (zz * (((((S0 * zz + S1) * zz + S2) * zz + S3) * zz + S4) * zz + S5));
+  V cosPoly =
+      1.0 - 0.5 * zz +
+      zz * zz * (((((C0 * zz + C1) * zz + C2) * zz + C3) * zz + C4) * zz + C5);
+
+  sin = Select(swap, cosPoly, sinPoly);
+  sin = Select(secondHalf ^ SignBit(angle), -sin, sin);
+
+  cos = Select(swap, sinPoly, cosPoly);
+  cos = Select(secondHalf ^ swap, -cos, cos);
+}
+
+}  // namespace
+
+std::string_view BatchInstructionSet() {
+  return kInstructionSet;
+}
+
+void BatchRotateBy(std::span<const double> x, std::span<const double> y,
+                   std::span<const double> cos, std::span<const double> sin,
+                   std::span<double> rotatedX, std::span<double> rotatedY) {
+  assert(y.size() == x.size() && cos.size() == x.size() &&
+         sin.size() == x.size() && rotatedX.size() == x.size() &&
+         rotatedY.size() == x.size());
+
+  ForEachBlock(x.size(), [&]<typename V>(size_t index) {
+    V pointX = V::Load(x.data() + index);
+    V pointY = V::Load(y.data() + index);
+    V c = V::Load(cos.data() + index);
+    V s = V::Load(sin.data() + index);
+
+    (pointX * c - pointY * s).Store(rotatedX.data() + index);
+    (pointX * s + pointY * c).Store(rotatedY.data() + index);
+  });
+}
+
+void BatchLinePointSquaredDistance(const Translation2d& lineStart,
+                                   const Translation2d& lineEnd,
+                                   std::span<const double> x,
+                                   std::span<const double> y,
+                                   std::span<double> squaredDistances) {
+  assert(y.size() == x.size() && squaredDistances.size() == x.size());
+
+  auto line = lineEnd - lineStart;
+  double squaredLength = line.SquaredNorm();
+
+  ForEachBlock(x.size(), [&]<typename V>(size_t index) {
+    V pointX = V::Load(x.data() + index);
+    V pointY = V::Load(y.data() + index);
+
+    // Project the point onto the line, then clamp it to the segment
+    V vX = pointX - lineStart.X();
+    V vY = pointY - lineStart.Y();
+    V t = (vX * line.X() + vY * line.Y()) / squaredLength;
+    V tBounded = Max(Min(t, 1.0), 0.0);
+
+    V dX = (lineStart.X() + tBounded * line.X()) - pointX;
+    V dY = (lineStart.Y() + tBounded * line.Y()) - pointY;
+    (dX * dX + dY * dY).Store(squaredDistances.data() + index);
+  });
+}
+
+void BatchRadians(std::span<const double> cos, std::span<const double> sin,
+                  std::span<double> radians) {
+  assert(sin.size() == cos.size() && radians.size() == cos.size());
+
+  ForEachBlock(cos.size(), [&]<typename V>(size_t index) {
+    Atan2(V::Load(sin.data() + index), V::Load(cos.data() + index))
+        .Store(radians.data() + index);
+  });
+}
+
+void BatchCosSin(std::span<const double> radians, std::span<double> cos,
+                 std::span<double> sin) {
+  assert(cos.size() == radians.size() && sin.size() == radians.size());
+
+  // One element at a time, the standard library beats the polynomials
+  if constexpr (std::same_as<NativeDouble, ScalarDouble>) {
+    for (size_t index = 0; index < radians.size(); ++index) {
+      double angle = radians[index];
+      cos[index] = std::cos(angle);
+      sin[index] = std::sin(angle);
+    }
+    return;
+  }
+
+  ForEachBlock(radians.size(), [&]<typename V>(size_t index) {
+    V c = 0.0;
+    V s = 0.0;
+    CosSin(V::Load(radians.data() + index), c, s);
+    c.Store(cos.data() + index);
+    s.Store(sin.data() + index);
+  });
+}
+
+}  // namespace trajopt
@@ -41,10 +41,56 @@ mod ffi {
         samples: Vec<HolonomicTrajectorySample>,
     }
 
+    #[derive(Debug, Deserialize, Serialize, Clone)]
+    struct ProgressOptions {
+        decimation: usize,
+        deltas: bool,
+        delta_tolerance: f64,
+    }
+
+    #[derive(Debug, Deserialize, Serialize, Clone)]
+    struct GenerationOptions {
+        tolerance: f64,
+        max_iterations: i32,
+        timeout: f64,
+        feasibility_only: bool,
+        diagnostics: bool,
+    }
+
+    extern "Rust" {
+        type JobWaker;
+        type ProgressCallback;
+
+        fn wake(self: &JobWaker);
+        fn call(self: &mut ProgressCallback, trajectory: &TrajectoryBuffer, handle: i64);
+    }
+
     unsafe extern "C++" {
         include!("RustFFI.hpp");
 
         type SwervePathBuilder;
+        type TrajectoryBuffer;
+
+        fn sample_count(self: &TrajectoryBuffer) -> usize;
+        fn module_count(self: &TrajectoryBuffer) -> usize;
+        fn changed_columns(self: &TrajectoryBuffer) -> u32;
+        fn timestamp(self: &TrajectoryBuffer) -> &[f64];
+        fn x(self: &TrajectoryBuffer) -> &[f64];
+        fn y(self: &TrajectoryBuffer) -> &[f64];
+        fn heading(self: &TrajectoryBuffer) -> &[f64];
+        fn velocity_x(self: &TrajectoryBuffer) -> &[f64];
+        fn velocity_y(self: &TrajectoryBuffer) -> &[f64];
+        fn angular_velocity(self: &TrajectoryBuffer) -> &[f64];
+        fn module_forces_x(self: &TrajectoryBuffer) -> &[f64];
+        fn module_forces_y(self: &TrajectoryBuffer) -> &[f64];
+
+        type GenerationJob;
+
+        fn is_done(self: &GenerationJob) -> bool;
+        fn cancel(self: &GenerationJob);
+        fn progress(self: &GenerationJob) -> UniquePtr<TrajectoryBuffer>;
+        fn result(self: &GenerationJob) -> Result<UniquePtr<TrajectoryBuffer>>;
+        fn set_waker(self: &GenerationJob, waker: Box<JobWaker>);
 
         fn set_drivetrain(self: Pin<&mut SwervePathBuilder>, drivetrain: &SwerveDrivetrain);
         fn set_bumpers(self: Pin<&mut SwervePathBuilder>, length: f64, width: f64);
@@ -151,19 +197,39 @@ mod ffi {
             radius: f64,
         );
 
-        fn generate(
+        fn generate_trajectory(
             self: &SwervePathBuilder,
-            diagnostics: bool,
+            options: &GenerationOptions,
             uuid: i64,
-        ) -> Result<HolonomicTrajectory>;
+        ) -> Result<UniquePtr<TrajectoryBuffer>>;
+
+        fn generate_async(
+            self: &SwervePathBuilder,
+            options: &GenerationOptions,
+            uuid: i64,
+        ) -> UniquePtr<GenerationJob>;
 
         fn add_progress_callback(
             self: Pin<&mut SwervePathBuilder>,
             callback: fn(HolonomicTrajectory, i64),
         );
+        fn add_trajectory_callback(
+            self: Pin<&mut SwervePathBuilder>,
+            callback: fn(&TrajectoryBuffer, i64),
+        );
+        fn add_progress_closure(
+            self: Pin<&mut SwervePathBuilder>,
+            callback: Box<ProgressCallback>,
+            options: &ProgressOptions,
+        );
+        fn set_callback_rate(self: Pin<&mut SwervePathBuilder>, rate: f64);
 
         fn swerve_path_builder_new() -> UniquePtr<SwervePathBuilder>;
 
+        fn default_generation_options() -> GenerationOptions;
+        fn preview_generation_options() -> GenerationOptions;
+        fn export_generation_options() -> GenerationOptions;
+
         fn cancel_all();
     }
 }
@@ -405,12 +471,74 @@ impl SwervePathBuilder {
         diagnostics: bool,
         handle: i64,
     ) -> Result<HolonomicTrajectory, String> {
-        match self.path_builder.generate(diagnostics, handle) {
+        let options = GenerationOptions {
+            diagnostics,
+            ..Default::default()
+        };
+        self.generate_with_options(&options, handle)
+    }
+
+    ///
+    /// Generate the trajectory with the given solver options;
+    ///
+    /// * options: The solver options. `GenerationOptions::preview()` trades
+    ///       accuracy for speed while a path is being edited.
+    /// * handle: A number used to identify results from this generation in the
+    ///       `add_progress_callback` callback. If `add_progress_callback` has
+    ///       not been called, this value has no significance.
+    ///
+    /// Returns a result with either the final `trajopt::HolonomicTrajectory`,
+    /// or a String error message if generation failed.
+    ///
+    pub fn generate_with_options(
+        &mut self,
+        options: &GenerationOptions,
+        handle: i64,
+    ) -> Result<HolonomicTrajectory, String> {
+        self.generate_trajectory(options, handle)
+            .map(|trajectory| trajectory.to_holonomic_trajectory())
+    }
+
+    ///
+    /// Generate the trajectory without converting it;
+    ///
+    /// * options: The solver options.
+    /// * handle: A number used to identify results from this generation in the
+    ///       progress callbacks.
+    ///
+    /// Returns a result with either the final `trajopt::TrajectoryBuffer`, whose
+    /// columns can be read as slices without copying, or a String error message
+    /// if generation failed.
+    ///
+    pub fn generate_trajectory(
+        &mut self,
+        options: &GenerationOptions,
+        handle: i64,
+    ) -> Result<cxx::UniquePtr<TrajectoryBuffer>, String> {
+        match self.path_builder.generate_trajectory(options, handle) {
             Ok(traj) => Ok(traj),
             Err(msg) => Err(msg.what().to_string()),
         }
     }
 
+    ///
+    /// Start generating the trajectory on a worker pool shared by every
+    /// asynchronous generation, without blocking;
+    ///
+    /// * options: The solver options.
+    /// * handle: A number used to identify results from this generation in the
+    ///       progress callbacks.
+    ///
+    /// Returns a `GenerationFuture` that resolves to the final trajectory, or a
+    /// String error message if generation failed or was canceled. Changes to
+    /// this path builder after this call don't affect the generation.
+    ///
+    pub fn generate_async(&self, options: &GenerationOptions, handle: i64) -> GenerationFuture {
+        GenerationFuture {
+            job: self.path_builder.generate_async(options, handle),
+        }
+    }
+
     ///
     /// Add a callback that will be called on each iteration of the solver.
     ///
@@ -424,6 +552,59 @@ impl SwervePathBuilder {
     pub fn add_progress_callback(&mut self, callback: fn(HolonomicTrajectory, i64)) {
         crate::ffi::SwervePathBuilder::add_progress_callback(self.path_builder.pin_mut(), callback);
     }
+
+    ///
+    /// Add a callback that will be called on each iteration of the solver,
+    /// without converting the trajectory.
+    ///
+    /// * callback: a `fn` (not a closure) to be executed. The callback's first
+    ///       parameter will be a `trajopt::TrajectoryBuffer` that's only valid
+    ///       during the call, and the second parameter will be an `i64` equal
+    ///       to the handle passed in `generate()`
+    ///
+    /// This function can be called multiple times to add multiple callbacks.
+    ///
+    pub fn add_trajectory_callback(&mut self, callback: fn(&TrajectoryBuffer, i64)) {
+        crate::ffi::SwervePathBuilder::add_trajectory_callback(
+            self.path_builder.pin_mut(),
+            callback,
+        );
+    }
+
+    ///
+    /// Add a closure that will be called on each iteration of the solver.
+    ///
+    /// * options: How much of each trajectory to send. A `decimation` of n
+    ///       sends every nth sample and the last one. With `deltas`, columns
+    ///       that haven't changed by more than `delta_tolerance` since they
+    ///       were last sent for the same handle are left empty; see
+    ///       `TrajectoryBuffer::is_changed()`.
+    /// * callback: The closure. Its first parameter will be a
+    ///       `trajopt::TrajectoryBuffer` that's only valid during the call, and
+    ///       the second parameter will be an `i64` equal to the handle passed
+    ///       in `generate()`. It may be called from the solver's threads.
+    ///
+    /// This function can be called multiple times to add multiple callbacks.
+    ///
+    pub fn add_progress_closure<F>(&mut self, options: &ProgressOptions, callback: F)
+    where
+        F: FnMut(&TrajectoryBuffer, i64) + Send + 'static,
+    {
+        crate::ffi::SwervePathBuilder::add_progress_closure(
+            self.path_builder.pin_mut(),
+            Box::new(ProgressCallback(Box::new(callback))),
+            options,
+        );
+    }
+
+    ///
+    /// Set the largest number of times per second the progress callbacks are
+    /// called. The default is 60, and `f64::INFINITY` calls them on every
+    /// iteration.
+    ///
+    pub fn set_callback_rate(&mut self, rate: f64) {
+        crate::ffi::SwervePathBuilder::set_callback_rate(self.path_builder.pin_mut(), rate);
+    }
 }
 
 impl Default for SwervePathBuilder {
@@ -432,12 +613,211 @@ impl Default for SwervePathBuilder {
     }
 }
 
+impl GenerationOptions {
+    ///
+    /// Options for quick previews while a path is being edited. The trajectory
+    /// is accurate to about a centimeter.
+    ///
+    pub fn preview() -> GenerationOptions {
+        crate::ffi::preview_generation_options()
+    }
+
+    ///
+    /// Options for final trajectories that will be followed by a robot.
+    ///
+    pub fn export() -> GenerationOptions {
+        crate::ffi::export_generation_options()
+    }
+}
+
+impl Default for GenerationOptions {
+    fn default() -> Self {
+        crate::ffi::default_generation_options()
+    }
+}
+
+// The C++ side only reads a trajectory buffer, and a generation job's state
+// is behind a mutex
+unsafe impl Send for TrajectoryBuffer {}
+unsafe impl Sync for TrajectoryBuffer {}
+unsafe impl Send for ffi::GenerationJob {}
+unsafe impl Sync for ffi::GenerationJob {}
+
+struct JobWaker(std::task::Waker);
+
+impl JobWaker {
+    fn wake(&self) {
+        self.0.wake_by_ref();
+    }
+}
+
+struct ProgressCallback(Box<dyn FnMut(&TrajectoryBuffer, i64) + Send>);
+
+impl ProgressCallback {
+    fn call(&mut self, trajectory: &TrajectoryBuffer, handle: i64) {
+        (self.0)(trajectory, handle);
+    }
+}
+
+impl Default for ProgressOptions {
+    fn default() -> Self {
+        ProgressOptions {
+            decimation: 1,
+            deltas: false,
+            delta_tolerance: 1e-3,
+        }
+    }
+}
+
+///
+/// A trajectory generation running on the shared worker pool, started by
+/// `SwervePathBuilder::generate_async()`.
+///
+/// Dropping the future cancels the generation.
+///
+pub struct GenerationFuture {
+    job: cxx::UniquePtr<ffi::GenerationJob>,
+}
+
+impl GenerationFuture {
+    ///
+    /// Returns true once the generation has finished, successfully or not.
+    ///
+    pub fn is_done(&self) -> bool {
+        self.job.is_done()
+    }
+
+    ///
+    /// Cancel this generation without affecting any others. The future then
+    /// resolves to an error.
+    ///
+    pub fn cancel(&self) {
+        self.job.cancel();
+    }
+
+    ///
+    /// Returns the latest intermediate trajectory the solver reported, or
+    /// `None` if it hasn't reported one yet.
+    ///
+    pub fn progress(&self) -> Option<cxx::UniquePtr<TrajectoryBuffer>> {
+        let progress = self.job.progress();
+        if progress.is_null() {
+            None
+        } else {
+            Some(progress)
+        }
+    }
+}
+
+impl std::future::Future for GenerationFuture {
+    type Output = Result<cxx::UniquePtr<TrajectoryBuffer>, String>;
+
+    fn poll(
+        self: std::pin::Pin<&mut Self>,
+        cx: &mut std::task::Context<'_>,
+    ) -> std::task::Poll<Self::Output> {
+        // Register the waker before checking, so a generation that finishes in
+        // between still wakes the task
+        self.job.set_waker(Box::new(JobWaker(cx.waker().clone())));
+        if !self.job.is_done() {
+            return std::task::Poll::Pending;
+        }
+
+        std::task::Poll::Ready(match self.job.result() {
+            Ok(traj) => Ok(traj),
+            Err(msg) => Err(msg.what().to_string()),
+        })
+    }
+}
+
+impl Drop for GenerationFuture {
+    fn drop(&mut self) {
+        self.job.cancel();
+    }
+}
+
+impl TrajectoryBuffer {
+    pub const TIMESTAMP: u32 = 1 << 0;
+    pub const X: u32 = 1 << 1;
+    pub const Y: u32 = 1 << 2;
+    pub const HEADING: u32 = 1 << 3;
+    pub const VELOCITY_X: u32 = 1 << 4;
+    pub const VELOCITY_Y: u32 = 1 << 5;
+    pub const ANGULAR_VELOCITY: u32 = 1 << 6;
+    pub const MODULE_FORCES_X: u32 = 1 << 7;
+    pub const MODULE_FORCES_Y: u32 = 1 << 8;
+    pub const ALL_COLUMNS: u32 = (1 << 9) - 1;
+
+    ///
+    /// Returns true if a column is present. Every column is, except in
+    /// progress updates with deltas enabled, where unchanged columns are
+    /// empty.
+    ///
+    /// * column: One of the column constants, like `TrajectoryBuffer::X`.
+    ///
+    pub fn is_changed(&self, column: u32) -> bool {
+        self.changed_columns() & column != 0
+    }
+
+    ///
+    /// The x forces of each module at a sample.
+    ///
+    pub fn sample_module_forces_x(&self, sample: usize) -> &[f64] {
+        let module_count = self.module_count();
+        &self.module_forces_x()[sample * module_count..(sample + 1) * module_count]
+    }
+
+    ///
+    /// The y forces of each module at a sample.
+    ///
+    pub fn sample_module_forces_y(&self, sample: usize) -> &[f64] {
+        let module_count = self.module_count();
+        &self.module_forces_y()[sample * module_count..(sample + 1) * module_count]
+    }
+
+    ///
+    /// Copies the trajectory into a serializable `HolonomicTrajectory`.
+    ///
+    /// Panics if any column is left out, as in a delta progress update.
+    ///
+    pub fn to_holonomic_trajectory(&self) -> HolonomicTrajectory {
+        assert_eq!(self.changed_columns(), Self::ALL_COLUMNS);
+
+        let timestamp = self.timestamp();
+        let x = self.x();
+        let y = self.y();
+        let heading = self.heading();
+        let velocity_x = self.velocity_x();
+        let velocity_y = self.velocity_y();
+        let angular_velocity = self.angular_velocity();
+
+        let samples = (0..self.sample_count())
+            .map(|sample| HolonomicTrajectorySample {
+                timestamp: timestamp[sample],
+                x: x[sample],
+                y: y[sample],
+                heading: heading[sample],
+                velocity_x: velocity_x[sample],
+                velocity_y: velocity_y[sample],
+                angular_velocity: angular_velocity[sample],
+                module_forces_x: self.sample_module_forces_x(sample).to_vec(),
+                module_forces_y: self.sample_module_forces_y(sample).to_vec(),
+            })
+            .collect();
+
+        HolonomicTrajectory { samples }
+    }
+}
+
 pub fn cancel_all() {
     crate::ffi::cancel_all();
 }
 
+pub use ffi::GenerationOptions;
 pub use ffi::HolonomicTrajectory;
 pub use ffi::HolonomicTrajectorySample;
 pub use ffi::Pose2d;
+pub use ffi::ProgressOptions;
 pub use ffi::SwerveDrivetrain;
 pub use ffi::SwerveModule;
+pub use ffi::TrajectoryBuffer;
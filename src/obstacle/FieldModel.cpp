@@ -0,0 +1,143 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/obstacle/FieldModel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "trajopt/obstacle/detail/ObstacleConstraints.hpp"
+
+namespace trajopt {
+
+FieldModel::FieldModel(std::vector<Obstacle> obstacles, double cellSize)
+    : m_obstacles{std::move(obstacles)}, m_cellSize{cellSize} {
+  assert(m_cellSize > 0.0);
+
+  if (m_obstacles.empty()) {
+    return;
+  }
+
+  m_bounds.reserve(m_obstacles.size());
+  for (const auto& obstacle : m_obstacles) {
+    double minX = INFINITY;
+    double minY = INFINITY;
+    double maxX = -INFINITY;
+    double maxY = -INFINITY;
+    for (const auto& point : obstacle.points) {
+      minX = std::min(minX, point.X());
+      minY = std::min(minY, point.Y());
+      maxX = std::max(maxX, point.X());
+      maxY = std::max(maxY, point.Y());
+    }
+    m_bounds.push_back(Bounds{
+        {minX - obstacle.safetyDistance, minY - obstacle.safetyDistance},
+        {maxX + obstacle.safetyDistance, maxY + obstacle.safetyDistance}});
+  }
+
+  // Obstacles without points have empty bounds, so they aren't in the grid
+  auto hasPoints = [&](size_t obstacleIndex) {
+    return !m_obstacles[obstacleIndex].points.empty();
+  };
+
+  double minX = INFINITY;
+  double minY = INFINITY;
+  double maxX = -INFINITY;
+  double maxY = -INFINITY;
+  for (size_t obstacleIndex = 0; obstacleIndex < m_bounds.size();
+       ++obstacleIndex) {
+    if (!hasPoints(obstacleIndex)) {
+      continue;
+    }
+    const auto& bounds = m_bounds[obstacleIndex];
+    minX = std::min(minX, bounds.min.X());
+    minY = std::min(minY, bounds.min.Y());
+    maxX = std::max(maxX, bounds.max.X());
+    maxY = std::max(maxY, bounds.max.Y());
+  }
+  if (minX > maxX) {
+    return;
+  }
+
+  m_gridOrigin = {minX, minY};
+  m_columnCount = static_cast<size_t>((maxX - minX) / m_cellSize) + 1;
+  m_rowCount = static_cast<size_t>((maxY - minY) / m_cellSize) + 1;
+  m_cells.resize(m_columnCount * m_rowCount);
+
+  for (size_t obstacleIndex = 0; obstacleIndex < m_bounds.size();
+       ++obstacleIndex) {
+    if (!hasPoints(obstacleIndex)) {
+      continue;
+    }
+    const auto& bounds = m_bounds[obstacleIndex];
+    size_t firstColumn =
+        static_cast<size_t>((bounds.min.X() - minX) / m_cellSize);
+    size_t lastColumn =
+        static_cast<size_t>((bounds.max.X() - minX) / m_cellSize);
+    size_t firstRow = static_cast<size_t>((bounds.min.Y() - minY) / m_cellSize);
+    size_t lastRow = static_cast<size_t>((bounds.max.Y() - minY) / m_cellSize);
+    for (size_t row = firstRow; row <= lastRow; ++row) {
+      for (size_t column = firstColumn; column <= lastColumn; ++column) {
+        m_cells[row * m_columnCount + column].push_back(obstacleIndex);
+      }
+    }
+  }
+}
+
+std::vector<size_t> FieldModel::ObstaclesNear(const Bounds& bounds) const {
+  std::vector<size_t> obstacleIndices;
+  if (m_cells.empty()) {
+    return obstacleIndices;
+  }
+
+  // Returns the range of cells covering [min, max] along one axis, clamped to
+  // the grid, or an empty range if they don't overlap
+  auto cellRange = [&](double min, double max, double origin, size_t count) {
+    double first = std::floor((min - origin) / m_cellSize);
+    double last = std::floor((max - origin) / m_cellSize);
+    if (last < 0.0 || first >= static_cast<double>(count)) {
+      return std::pair<size_t, size_t>{1, 0};
+    }
+    return std::pair{
+        static_cast<size_t>(std::max(first, 0.0)),
+        static_cast<size_t>(std::min(last, static_cast<double>(count - 1)))};
+  };
+  auto [firstColumn, lastColumn] = cellRange(
+      bounds.min.X(), bounds.max.X(), m_gridOrigin.X(), m_columnCount);
+  auto [firstRow, lastRow] =
+      cellRange(bounds.min.Y(), bounds.max.Y(), m_gridOrigin.Y(), m_rowCount);
+
+  for (size_t row = firstRow; row <= lastRow && firstColumn <= lastColumn;
+       ++row) {
+    for (size_t column = firstColumn; column <= lastColumn; ++column) {
+      for (size_t obstacleIndex : m_cells[row * m_columnCount + column]) {
+        // The cells are coarser than the obstacles' bounds
+        const auto& obstacleBounds = m_bounds[obstacleIndex];
+        if (obstacleBounds.max.X() >= bounds.min.X() &&
+            obstacleBounds.min.X() <= bounds.max.X() &&
+            obstacleBounds.max.Y() >= bounds.min.Y() &&
+            obstacleBounds.min.Y() <= bounds.max.Y()) {
+          obstacleIndices.push_back(obstacleIndex);
+        }
+      }
+    }
+  }
+
+  // Obstacles spanning several cells were found once per cell
+  std::sort(obstacleIndices.begin(), obstacleIndices.end());
+  obstacleIndices.erase(
+      std::unique(obstacleIndices.begin(), obstacleIndices.end()),
+      obstacleIndices.end());
+  return obstacleIndices;
+}
+
+void FieldModel::AppendConstraints(const Bumpers& bumpers, size_t obstacleIndex,
+                                   std::vector<Constraint>& constraints) const {
+  detail::AppendObstacleConstraints(bumpers, m_obstacles[obstacleIndex],
+                                    constraints);
+}
+
+}  // namespace trajopt
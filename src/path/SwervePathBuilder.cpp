@@ -2,17 +2,22 @@
 
 #include "trajopt/path/SwervePathBuilder.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <memory>
 #include <utility>
+#include <vector>
 
-#include "trajopt/constraint/LinePointConstraint.hpp"
-#include "trajopt/constraint/PointLineConstraint.hpp"
-#include "trajopt/constraint/PointPointConstraint.hpp"
 #include "trajopt/constraint/PoseEqualityConstraint.hpp"
 #include "trajopt/constraint/TranslationEqualityConstraint.hpp"
+#include "trajopt/obstacle/FieldModel.hpp"
 #include "trajopt/obstacle/Obstacle.hpp"
+#include "trajopt/obstacle/detail/ObstacleConstraints.hpp"
 #include "trajopt/solution/SwerveSolution.hpp"
 #include "trajopt/util/Cancellation.hpp"
-#include "trajopt/util/GenerateLinearInitialGuess.hpp"
+#include "trajopt/util/GenerateSplineInitialGuess.hpp"
+#include "trajopt/util/InitialGuessPlanner.hpp"
+#include "trajopt/util/TimeParameterizeInitialGuess.hpp"
 
 namespace trajopt {
 
@@ -20,10 +25,30 @@ SwervePath& SwervePathBuilder::GetPath() {
   return path;
 }
 
+const SwervePath& SwervePathBuilder::GetPath() const {
+  return path;
+}
+
 void SwervePathBuilder::SetDrivetrain(SwerveDrivetrain drivetrain) {
   path.drivetrain = std::move(drivetrain);
 }
 
+void SwervePathBuilder::SetObjective(const Objective& objective) {
+  path.objective = objective;
+}
+
+void SwervePathBuilder::SetTranscription(Transcription transcription) {
+  path.transcription = transcription;
+}
+
+void SwervePathBuilder::TotalTime(double time) {
+  path.totalTime = time;
+}
+
+void SwervePathBuilder::MaxTotalTime(double time) {
+  path.maxTotalTime = time;
+}
+
 void SwervePathBuilder::PoseWpt(size_t index, double x, double y,
                                 double heading) {
   WptConstraint(index, PoseEqualityConstraint{x, y, heading});
@@ -52,131 +77,44 @@ void SwervePathBuilder::SgmtInitialGuessPoints(
 }
 
 void SwervePathBuilder::AddBumpers(Bumpers&& newBumpers) {
-  bumpers.emplace_back(std::move(newBumpers));
+  path.bumpers.emplace_back(std::move(newBumpers));
 }
 
 void SwervePathBuilder::WptObstacle(size_t index, const Obstacle& obstacle) {
-  for (auto& _bumpers : bumpers) {
-    auto minDistance = _bumpers.safetyDistance + obstacle.safetyDistance;
-
-    size_t bumperCornerCount = _bumpers.points.size();
-    size_t obstacleCornerCount = obstacle.points.size();
-    if (bumperCornerCount == 1 && obstacleCornerCount == 1) {
-      // if the bumpers and obstacle are only one point
-      WptConstraint(index,
-                    PointPointConstraint{_bumpers.points.at(0),
-                                         obstacle.points.at(0), minDistance});
-      return;
-    }
-
-    // robot bumper edge to obstacle point constraints
-    for (auto& obstaclePoint : obstacle.points) {
-      // First apply constraint for all but last edge
-      for (size_t bumperCornerIndex = 0;
-           bumperCornerIndex < bumperCornerCount - 1; bumperCornerIndex++) {
-        WptConstraint(index, LinePointConstraint{
-                                 _bumpers.points.at(bumperCornerIndex),
-                                 _bumpers.points.at(bumperCornerIndex + 1),
-                                 obstaclePoint, minDistance});
-      }
-      // apply to last edge: the edge connecting the last point to the first
-      // must have at least three points to need this
-      if (bumperCornerCount >= 3) {
-        WptConstraint(index,
-                      LinePointConstraint{
-                          _bumpers.points.at(bumperCornerCount - 1),
-                          _bumpers.points.at(0), obstaclePoint, minDistance});
-      }
-    }
-
-    // obstacle edge to bumper corner constraints
-    for (auto& bumperCorner : _bumpers.points) {
-      if (obstacleCornerCount > 1) {
-        for (size_t obstacleCornerIndex = 0;
-             obstacleCornerIndex < obstacleCornerCount - 1;
-             obstacleCornerIndex++) {
-          WptConstraint(
-              index,
-              PointLineConstraint{
-                  bumperCorner, obstacle.points.at(obstacleCornerIndex),
-                  obstacle.points.at(obstacleCornerIndex + 1), minDistance});
-        }
-        if (obstacleCornerCount >= 3) {
-          WptConstraint(index, PointLineConstraint{
-                                   bumperCorner,
-                                   obstacle.points.at(bumperCornerCount - 1),
-                                   obstacle.points.at(0), minDistance});
-        }
-      } else {
-        WptConstraint(index,
-                      PointPointConstraint{bumperCorner, obstacle.points.at(0),
-                                           minDistance});
-      }
-    }
+  std::vector<Constraint> constraints;
+  for (auto& _bumpers : path.bumpers) {
+    detail::AppendObstacleConstraints(_bumpers, obstacle, constraints);
+  }
+  for (auto& constraint : constraints) {
+    WptConstraint(index, constraint);
   }
 }
 
 void SwervePathBuilder::SgmtObstacle(size_t fromIndex, size_t toIndex,
                                      const Obstacle& obstacle) {
-  for (auto& _bumpers : bumpers) {
-    auto minDistance = _bumpers.safetyDistance + obstacle.safetyDistance;
-
-    size_t bumperCornerCount = _bumpers.points.size();
-    size_t obstacleCornerCount = obstacle.points.size();
-    if (bumperCornerCount == 1 && obstacleCornerCount == 1) {
-      // if the bumpers and obstacle are only one point
-      SgmtConstraint(fromIndex, toIndex,
-                     PointPointConstraint{_bumpers.points.at(0),
-                                          obstacle.points.at(0), minDistance});
-      return;
-    }
+  NewWpts(toIndex);
+  for (size_t index = fromIndex + 1; index <= toIndex; ++index) {
+    segmentObstacles.at(index).push_back(obstacle);
+  }
 
-    // robot bumper edge to obstacle point constraints
-    for (auto& obstaclePoint : obstacle.points) {
-      // First apply constraint for all but last edge
-      for (size_t bumperCornerIndex = 0;
-           bumperCornerIndex < bumperCornerCount - 1; bumperCornerIndex++) {
-        SgmtConstraint(
-            fromIndex, toIndex,
-            LinePointConstraint{_bumpers.points.at(bumperCornerIndex),
-                                _bumpers.points.at(bumperCornerIndex + 1),
-                                obstaclePoint, minDistance});
-      }
-      // apply to last edge: the edge connecting the last point to the first
-      // must have at least three points to need this
-      if (bumperCornerCount >= 3) {
-        SgmtConstraint(fromIndex, toIndex,
-                       LinePointConstraint{
-                           _bumpers.points.at(bumperCornerCount - 1),
-                           _bumpers.points.at(0), obstaclePoint, minDistance});
-      }
-    }
+  std::vector<Constraint> constraints;
+  for (auto& _bumpers : path.bumpers) {
+    detail::AppendObstacleConstraints(_bumpers, obstacle, constraints);
+  }
+  for (auto& constraint : constraints) {
+    SgmtConstraint(fromIndex, toIndex, constraint);
+  }
+}
 
-    // obstacle edge to bumper corner constraints
-    for (auto& bumperCorner : _bumpers.points) {
-      if (obstacleCornerCount > 1) {
-        for (size_t obstacleCornerIndex = 0;
-             obstacleCornerIndex < obstacleCornerCount - 1;
-             obstacleCornerIndex++) {
-          SgmtConstraint(
-              fromIndex, toIndex,
-              PointLineConstraint{
-                  bumperCorner, obstacle.points.at(obstacleCornerIndex),
-                  obstacle.points.at(obstacleCornerIndex + 1), minDistance});
-        }
-        if (obstacleCornerCount >= 3) {
-          SgmtConstraint(
-              fromIndex, toIndex,
-              PointLineConstraint{bumperCorner,
-                                  obstacle.points.at(bumperCornerCount - 1),
-                                  obstacle.points.at(0), minDistance});
-        }
-      } else {
-        SgmtConstraint(fromIndex, toIndex,
-                       PointPointConstraint{bumperCorner, obstacle.points.at(0),
-                                            minDistance});
-      }
-    }
+void SwervePathBuilder::SetField(std::shared_ptr<const FieldModel> field) {
+  path.field = std::move(field);
+}
+
+void SwervePathBuilder::SgmtFieldObstacles(size_t fromIndex, size_t toIndex,
+                                           double cullDistance) {
+  NewWpts(toIndex);
+  for (size_t index = fromIndex + 1; index <= toIndex; ++index) {
+    path.waypoints.at(index).fieldCullDistance = cullDistance;
   }
 }
 
@@ -189,8 +127,81 @@ const std::vector<size_t>& SwervePathBuilder::GetControlIntervalCounts() const {
 }
 
 SwerveSolution SwervePathBuilder::CalculateInitialGuess() const {
-  return GenerateLinearInitialGuess<SwerveSolution>(initialGuessPoints,
-                                                    controlIntervalCounts);
+  auto guessPoints = initialGuessPoints;
+
+  for (size_t wptIndex = 1; wptIndex < guessPoints.size(); ++wptIndex) {
+    auto& sgmtGuessPoints = guessPoints.at(wptIndex);
+
+    // Leave segments the user already guessed alone
+    const auto& fieldCullDistance =
+        path.waypoints.at(wptIndex).fieldCullDistance;
+    bool avoidsField = path.field && fieldCullDistance;
+    if (sgmtGuessPoints.size() > 1 ||
+        (segmentObstacles.at(wptIndex).empty() && !avoidsField)) {
+      continue;
+    }
+
+    const auto& start = guessPoints.at(wptIndex - 1).back();
+    const auto& end = sgmtGuessPoints.back();
+
+    auto obstacles = segmentObstacles.at(wptIndex);
+    if (avoidsField) {
+      double margin = *fieldCullDistance + detail::BumpersReach(path.bumpers);
+      FieldModel::Bounds bounds{
+          {std::min(start.X(), end.X()) - margin,
+           std::min(start.Y(), end.Y()) - margin},
+          {std::max(start.X(), end.X()) + margin,
+           std::max(start.Y(), end.Y()) + margin}};
+      for (size_t obstacleIndex : path.field->ObstaclesNear(bounds)) {
+        obstacles.push_back(path.field->GetObstacles()[obstacleIndex]);
+      }
+    }
+
+    InitialGuessPlanner planner{path.bumpers, obstacles};
+    auto sgmtPoseGuess = planner.PlanPoses(start, end);
+
+    // Each guess point needs at least one sample
+    if (sgmtPoseGuess &&
+        sgmtPoseGuess->size() < controlIntervalCounts.at(wptIndex - 1)) {
+      sgmtGuessPoints.insert(sgmtGuessPoints.begin(), sgmtPoseGuess->begin(),
+                             sgmtPoseGuess->end());
+    }
+  }
+
+  return TimeParameterizeInitialGuess(
+      GenerateSplineInitialGuess<SwerveSolution>(guessPoints,
+                                                 controlIntervalCounts),
+      path.drivetrain, controlIntervalCounts);
+}
+
+SwervePathBuilder SwervePathBuilder::Slice(size_t fromIndex,
+                                           size_t toIndex) const {
+  assert(fromIndex < toIndex && toIndex < path.waypoints.size());
+
+  SwervePathBuilder slice;
+  slice.path.drivetrain = path.drivetrain;
+  slice.path.objective = path.objective;
+  slice.path.transcription = path.transcription;
+  slice.path.waypoints.assign(path.waypoints.begin() + fromIndex,
+                              path.waypoints.begin() + toIndex + 1);
+  slice.path.waypoints.front().segmentConstraints.clear();
+
+  slice.path.bumpers = path.bumpers;
+  slice.path.field = path.field;
+  slice.path.waypoints.front().fieldCullDistance.reset();
+  slice.segmentObstacles.assign(segmentObstacles.begin() + fromIndex,
+                                segmentObstacles.begin() + toIndex + 1);
+  slice.segmentObstacles.front().clear();
+
+  slice.initialGuessPoints.assign(initialGuessPoints.begin() + fromIndex,
+                                  initialGuessPoints.begin() + toIndex + 1);
+  slice.initialGuessPoints.front() = {initialGuessPoints.at(fromIndex).back()};
+
+  slice.controlIntervalCounts.assign(
+      controlIntervalCounts.begin() + fromIndex,
+      controlIntervalCounts.begin() + toIndex);
+
+  return slice;
 }
 
 void SwervePathBuilder::AddIntermediateCallback(
@@ -198,6 +209,15 @@ void SwervePathBuilder::AddIntermediateCallback(
   path.callbacks.push_back(callback);
 }
 
+void SwervePathBuilder::SetCallbackRate(double rate) {
+  assert(rate > 0.0);
+  path.callbackRate = rate;
+}
+
+void SwervePathBuilder::SetCallbackThread(bool enabled) {
+  path.callbackThread = enabled;
+}
+
 void SwervePathBuilder::NewWpts(size_t finalIndex) {
   int64_t targetIndex = finalIndex;
   int64_t greatestIndex = path.waypoints.size() - 1;
@@ -205,6 +225,7 @@ void SwervePathBuilder::NewWpts(size_t finalIndex) {
     for (int64_t i = greatestIndex + 1; i <= targetIndex; ++i) {
       path.waypoints.emplace_back();
       initialGuessPoints.emplace_back(std::vector<Pose2d>{{0.0, 0.0, {0.0}}});
+      segmentObstacles.emplace_back();
       if (i != 0) {
         controlIntervalCounts.push_back(40);
       }
@@ -0,0 +1,18 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/path/SwervePathSpec.hpp"
+
+#include <mutex>
+
+#include "trajopt/solution/SwerveSolution.hpp"
+
+namespace trajopt {
+
+const SwerveSolution& SwervePathSpec::GetInitialGuess() const {
+  std::call_once(m_initialGuessFlag, [this] {
+    m_initialGuess = m_pathBuilder.CalculateInitialGuess();
+  });
+  return *m_initialGuess;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,272 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/InitialGuessPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trajopt/geometry/Rotation2.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/// The number of candidate corners placed around each obstacle vertex.
+constexpr int kCornersPerVertex = 8;
+
+/// Extra distance between candidate corners and inflated obstacles (m), so the
+/// initial guess doesn't start out on the boundary of the constraints.
+constexpr double kCornerClearance = 0.05;
+
+double PointSegmentSquaredDistance(const Translation2d& point,
+                                   const Translation2d& start,
+                                   const Translation2d& end) {
+  auto direction = end - start;
+  double squaredLength = direction.SquaredNorm();
+  if (squaredLength == 0.0) {
+    return (point - start).SquaredNorm();
+  }
+
+  double t = std::clamp((point - start).Dot(direction) / squaredLength, 0.0,
+                        1.0);
+  return (start + direction * t - point).SquaredNorm();
+}
+
+double SegmentSegmentSquaredDistance(const Translation2d& a,
+                                     const Translation2d& b,
+                                     const Translation2d& c,
+                                     const Translation2d& d) {
+  // The segments cross if each one's endpoints lie on opposite sides of the
+  // other
+  double abc = (b - a).Cross(c - a);
+  double abd = (b - a).Cross(d - a);
+  double cda = (d - c).Cross(a - c);
+  double cdb = (d - c).Cross(b - c);
+  if (abc * abd < 0.0 && cda * cdb < 0.0) {
+    return 0.0;
+  }
+
+  return std::min({PointSegmentSquaredDistance(a, c, d),
+                   PointSegmentSquaredDistance(b, c, d),
+                   PointSegmentSquaredDistance(c, a, b),
+                   PointSegmentSquaredDistance(d, a, b)});
+}
+
+bool PolygonContains(const std::vector<Translation2d>& polygon,
+                     const Translation2d& point) {
+  if (polygon.size() < 3) {
+    return false;
+  }
+
+  // Count crossings of a ray cast from the point in the +x direction
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const auto& p = polygon[i];
+    const auto& q = polygon[j];
+    if ((p.Y() > point.Y()) != (q.Y() > point.Y()) &&
+        point.X() <
+            (q.X() - p.X()) * (point.Y() - p.Y()) / (q.Y() - p.Y()) + p.X()) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+double ObstacleSegmentSquaredDistance(const std::vector<Translation2d>& polygon,
+                                      const Translation2d& start,
+                                      const Translation2d& end) {
+  if (PolygonContains(polygon, start)) {
+    return 0.0;
+  }
+
+  double squaredDistance = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    squaredDistance = std::min(
+        squaredDistance,
+        SegmentSegmentSquaredDistance(start, end, polygon[i],
+                                      polygon[(i + 1) % polygon.size()]));
+  }
+  return squaredDistance;
+}
+
+}  // namespace
+
+InitialGuessPlanner::InitialGuessPlanner(
+    const std::vector<Bumpers>& bumpers,
+    const std::vector<Obstacle>& obstacles) {
+  if (bumpers.empty()) {
+    return;
+  }
+
+  // Radius of a circle centered on the robot enclosing every bumper
+  double robotRadius = 0.0;
+  for (const auto& _bumpers : bumpers) {
+    for (const auto& point : _bumpers.points) {
+      robotRadius =
+          std::max(robotRadius, point.Norm() + _bumpers.safetyDistance);
+    }
+  }
+
+  for (const auto& obstacle : obstacles) {
+    if (!obstacle.points.empty()) {
+      m_obstacles.push_back(
+          {obstacle.points, robotRadius + obstacle.safetyDistance});
+    }
+  }
+
+  // Surround each vertex with a polygon of candidate corners that circumscribes
+  // its inflated circle, so edges between adjacent corners stay clear of it
+  for (const auto& obstacle : m_obstacles) {
+    double cornerRadius =
+        obstacle.radius / std::cos(std::numbers::pi / kCornersPerVertex) +
+        kCornerClearance;
+    for (const auto& vertex : obstacle.points) {
+      for (int i = 0; i < kCornersPerVertex; ++i) {
+        Translation2d corner =
+            vertex +
+            Translation2d{cornerRadius,
+                          Rotation2d{2.0 * std::numbers::pi * i /
+                                     kCornersPerVertex}};
+        bool isFree = std::none_of(
+            m_obstacles.begin(), m_obstacles.end(),
+            [&](const InflatedObstacle& other) {
+              return ObstacleSegmentSquaredDistance(other.points, corner,
+                                                    corner) <
+                     other.radius * other.radius;
+            });
+        if (isFree) {
+          m_corners.push_back(corner);
+        }
+      }
+    }
+  }
+}
+
+expected<std::vector<Translation2d>, std::string> InitialGuessPlanner::Plan(
+    const Translation2d& start, const Translation2d& goal) const {
+  // Node 0 is the start, node 1 is the goal, and the rest are corners
+  constexpr size_t kStart = 0;
+  constexpr size_t kGoal = 1;
+  std::vector<Translation2d> nodes{start, goal};
+  nodes.insert(nodes.end(), m_corners.begin(), m_corners.end());
+
+  auto isInside = [&](const Translation2d& point) {
+    std::vector<bool> inside;
+    inside.reserve(m_obstacles.size());
+    for (const auto& obstacle : m_obstacles) {
+      inside.push_back(
+          ObstacleSegmentSquaredDistance(obstacle.points, point, point) <
+          obstacle.radius * obstacle.radius);
+    }
+    return inside;
+  };
+  auto startInside = isInside(start);
+  auto goalInside = isInside(goal);
+
+  auto isVisible = [&](size_t from, size_t to) {
+    for (size_t i = 0; i < m_obstacles.size(); ++i) {
+      if (((from == kStart || to == kStart) && startInside[i]) ||
+          ((from == kGoal || to == kGoal) && goalInside[i])) {
+        continue;
+      }
+      const auto& obstacle = m_obstacles[i];
+      if (ObstacleSegmentSquaredDistance(obstacle.points, nodes[from],
+                                         nodes[to]) <
+          obstacle.radius * obstacle.radius) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (isVisible(kStart, kGoal)) {
+    return std::vector<Translation2d>{};
+  }
+
+  // A* over the visibility graph, checking edges as they're reached
+  constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+  std::vector<double> cost(nodes.size(),
+                           std::numeric_limits<double>::infinity());
+  std::vector<size_t> parent(nodes.size(), kNoParent);
+  std::vector<bool> closed(nodes.size(), false);
+
+  using Entry = std::pair<double, size_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  cost[kStart] = 0.0;
+  open.emplace(start.Distance(goal), kStart);
+
+  while (!open.empty()) {
+    size_t node = open.top().second;
+    open.pop();
+    if (closed[node]) {
+      continue;
+    }
+    closed[node] = true;
+
+    if (node == kGoal) {
+      std::vector<Translation2d> corners;
+      for (size_t index = parent[kGoal]; index != kStart;
+           index = parent[index]) {
+        corners.push_back(nodes[index]);
+      }
+      std::reverse(corners.begin(), corners.end());
+      return corners;
+    }
+
+    for (size_t next = 0; next < nodes.size(); ++next) {
+      if (closed[next]) {
+        continue;
+      }
+      double nextCost = cost[node] + nodes[node].Distance(nodes[next]);
+      if (nextCost < cost[next] && isVisible(node, next)) {
+        cost[next] = nextCost;
+        parent[next] = node;
+        open.emplace(nextCost + nodes[next].Distance(goal), next);
+      }
+    }
+  }
+
+  return unexpected{
+      std::string{"Obstacles block every route between start and goal"}};
+}
+
+expected<std::vector<Pose2d>, std::string> InitialGuessPlanner::PlanPoses(
+    const Pose2d& start, const Pose2d& goal) const {
+  auto corners = Plan(start.Translation(), goal.Translation());
+  if (!corners) {
+    return unexpected{corners.error()};
+  }
+
+  // Distance along the polyline to each corner, then to the goal
+  std::vector<double> distances;
+  distances.reserve(corners->size() + 1);
+  Translation2d previous = start.Translation();
+  double distance = 0.0;
+  for (const auto& corner : *corners) {
+    distance += previous.Distance(corner);
+    distances.push_back(distance);
+    previous = corner;
+  }
+  double totalDistance = distance + previous.Distance(goal.Translation());
+
+  double startHeading = start.Rotation().Radians();
+  double headingChange = (goal.Rotation() - start.Rotation()).Radians();
+
+  std::vector<Pose2d> poses;
+  poses.reserve(corners->size());
+  for (size_t i = 0; i < corners->size(); ++i) {
+    poses.emplace_back(
+        (*corners)[i],
+        startHeading + headingChange * distances[i] / totalDistance);
+  }
+  return poses;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,356 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/PrimitiveLibrary.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trajopt/geometry/Rotation2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+
+namespace trajopt {
+
+namespace {
+
+bool SameDrivetrain(const SwerveDrivetrain& lhs, const SwerveDrivetrain& rhs) {
+  if (lhs.mass != rhs.mass || lhs.moi != rhs.moi ||
+      lhs.modules.size() != rhs.modules.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.modules.size(); ++i) {
+    const auto& l = lhs.modules[i];
+    const auto& r = rhs.modules[i];
+    if (l.translation.X() != r.translation.X() ||
+        l.translation.Y() != r.translation.Y() ||
+        l.wheelRadius != r.wheelRadius ||
+        l.wheelMaxAngularVelocity != r.wheelMaxAngularVelocity ||
+        l.wheelMaxTorque != r.wheelMaxTorque) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Pose2d SamplePose(const SwerveSolution& solution, size_t index) {
+  return Pose2d{solution.x[index], solution.y[index],
+                Rotation2d{solution.thetacos[index], solution.thetasin[index]}};
+}
+
+/// Returns the end pose relative to the start pose.
+Pose2d RelativePose(const Pose2d& start, const Pose2d& end) {
+  return Pose2d{(end.Translation() - start.Translation())
+                    .RotateBy(-start.Rotation()),
+                end.Rotation() - start.Rotation()};
+}
+
+double SquaredDistance(const std::array<double, 3>& lhs,
+                       const std::array<double, 3>& rhs) {
+  double squaredDistance = 0.0;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    squaredDistance += (lhs[axis] - rhs[axis]) * (lhs[axis] - rhs[axis]);
+  }
+  return squaredDistance;
+}
+
+}  // namespace
+
+PrimitiveLibrary::PrimitiveLibrary(SwerveDrivetrain drivetrain)
+    : m_drivetrain{std::move(drivetrain)} {
+  for (const auto& module : m_drivetrain.modules) {
+    m_headingWeight = std::max(m_headingWeight, module.translation.Norm());
+  }
+}
+
+expected<void, std::string> PrimitiveLibrary::Add(
+    const SwerveSolution& solution,
+    const std::vector<size_t>& controlIntervalCounts) {
+  const auto& N = controlIntervalCounts;
+  size_t wptCnt = 1 + N.size();
+  size_t sampTot = GetIndex(N, wptCnt, 0);
+  size_t moduleCnt = m_drivetrain.modules.size();
+
+  for (const auto* column :
+       {&solution.x, &solution.y, &solution.thetacos, &solution.thetasin,
+        &solution.vx, &solution.vy, &solution.omega, &solution.ax,
+        &solution.ay, &solution.alpha}) {
+    if (column->size() != sampTot) {
+      return unexpected{std::string{
+          "Solution sample count doesn't match control interval counts"}};
+    }
+  }
+  if (solution.moduleFX.size() != sampTot ||
+      solution.moduleFY.size() != sampTot) {
+    return unexpected{std::string{
+        "Solution sample count doesn't match control interval counts"}};
+  }
+  for (size_t index = 0; index < sampTot; ++index) {
+    if (solution.moduleFX[index].size() != moduleCnt ||
+        solution.moduleFY[index].size() != moduleCnt) {
+      return unexpected{
+          std::string{"Solution module count doesn't match drivetrain"}};
+    }
+  }
+
+  // Solutions from the generator have one dt per control interval, and
+  // initial guesses have one per sample
+  size_t dtOffset;
+  if (solution.dt.size() == sampTot) {
+    dtOffset = 0;
+  } else if (solution.dt.size() + 1 == sampTot) {
+    dtOffset = 1;
+  } else {
+    return unexpected{std::string{
+        "Solution dt count doesn't match control interval counts"}};
+  }
+
+  for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
+    if (N.at(sgmtIndex) == 0) {
+      continue;
+    }
+
+    size_t startIndex = GetIndex(N, sgmtIndex + 1, 0) - 1;
+    size_t endIndex = GetIndex(N, sgmtIndex + 2, 0) - 1;
+
+    auto start = SamplePose(solution, startIndex);
+    auto inverseRotation = -start.Rotation();
+
+    SwervePrimitive primitive{
+        RelativePose(start, SamplePose(solution, endIndex)), 0.0, {}};
+    auto& samples = primitive.samples;
+    for (size_t index = startIndex; index <= endIndex; ++index) {
+      if (index > startIndex) {
+        primitive.totalTime += solution.dt[index - dtOffset];
+      }
+
+      auto pose = RelativePose(start, SamplePose(solution, index));
+      samples.x.push_back(pose.X());
+      samples.y.push_back(pose.Y());
+      samples.thetacos.push_back(pose.Rotation().Cos());
+      samples.thetasin.push_back(pose.Rotation().Sin());
+
+      auto v = Translation2d{solution.vx[index], solution.vy[index]}.RotateBy(
+          inverseRotation);
+      samples.vx.push_back(v.X());
+      samples.vy.push_back(v.Y());
+      samples.omega.push_back(solution.omega[index]);
+
+      auto a = Translation2d{solution.ax[index], solution.ay[index]}.RotateBy(
+          inverseRotation);
+      samples.ax.push_back(a.X());
+      samples.ay.push_back(a.Y());
+      samples.alpha.push_back(solution.alpha[index]);
+
+      auto& moduleFX = samples.moduleFX.emplace_back();
+      auto& moduleFY = samples.moduleFY.emplace_back();
+      for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
+        auto F = Translation2d{solution.moduleFX[index][moduleIndex],
+                               solution.moduleFY[index][moduleIndex]}
+                     .RotateBy(inverseRotation);
+        moduleFX.push_back(F.X());
+        moduleFY.push_back(F.Y());
+      }
+    }
+
+    m_keys.push_back(Key(primitive.delta));
+    m_primitives.push_back(std::move(primitive));
+  }
+
+  // Adding is rare compared to looking up, so rebuild the whole tree
+  m_tree.resize(m_primitives.size());
+  std::iota(m_tree.begin(), m_tree.end(), 0);
+  BuildTree(0, m_tree.size(), 0);
+
+  return {};
+}
+
+const SwervePrimitive* PrimitiveLibrary::Nearest(const Pose2d& start,
+                                                 const Pose2d& end) const {
+  if (m_primitives.empty()) {
+    return nullptr;
+  }
+
+  size_t nearest = 0;
+  double nearestSquaredDistance = std::numeric_limits<double>::infinity();
+  SearchTree(0, m_tree.size(), 0, Key(RelativePose(start, end)), nearest,
+             nearestSquaredDistance);
+  return &m_primitives[nearest];
+}
+
+expected<SwerveSolution, std::string> PrimitiveLibrary::InitialGuess(
+    const SwervePathBuilder& path, double maxDistance) const {
+  if (!SameDrivetrain(path.GetPath().drivetrain, m_drivetrain)) {
+    return unexpected{
+        std::string{"Path drivetrain doesn't match primitive library"}};
+  }
+
+  const auto& N = path.GetControlIntervalCounts();
+  size_t wptCnt = 1 + N.size();
+  size_t sampTot = GetIndex(N, wptCnt, 0);
+  size_t moduleCnt = m_drivetrain.modules.size();
+
+  auto guess = path.CalculateInitialGuess();
+
+  // Fill in any channels the path's own guess doesn't have
+  for (auto* column : {&guess.vx, &guess.vy, &guess.omega, &guess.ax,
+                       &guess.ay, &guess.alpha}) {
+    column->resize(sampTot, 0.0);
+  }
+  guess.dt.resize(sampTot, 0.0);
+  guess.moduleFX.resize(sampTot, std::vector<double>(moduleCnt, 0.0));
+  guess.moduleFY.resize(sampTot, std::vector<double>(moduleCnt, 0.0));
+
+  for (size_t sgmtIndex = 0; sgmtIndex < N.size(); ++sgmtIndex) {
+    if (N.at(sgmtIndex) == 0) {
+      continue;
+    }
+
+    size_t startIndex = GetIndex(N, sgmtIndex + 1, 0) - 1;
+    size_t endIndex = GetIndex(N, sgmtIndex + 2, 0) - 1;
+
+    auto start = SamplePose(guess, startIndex);
+    auto end = SamplePose(guess, endIndex);
+    const auto* primitive = Nearest(start, end);
+    if (primitive == nullptr) {
+      break;
+    }
+
+    auto delta = RelativePose(start, end);
+    if (SquaredDistance(Key(delta), Key(primitive->delta)) >
+        maxDistance * maxDistance) {
+      continue;
+    }
+
+    // Spread the primitive's end pose error along the segment
+    auto translationError =
+        delta.Translation() - primitive->delta.Translation();
+    double headingError =
+        (delta.Rotation() - primitive->delta.Rotation()).Radians();
+
+    const auto& samples = primitive->samples;
+    size_t M = samples.x.size() - 1;
+    size_t N_sgmt = N.at(sgmtIndex);
+    for (size_t sampIndex = 1; sampIndex <= N_sgmt; ++sampIndex) {
+      size_t index = startIndex + sampIndex;
+
+      // Interpolate between the primitive's samples at the same fraction of
+      // the segment
+      double progress = static_cast<double>(sampIndex) / N_sgmt;
+      double position = progress * M;
+      size_t j = std::min(static_cast<size_t>(position), M - 1);
+      double t = position - j;
+      auto lerp = [&](const std::vector<double>& column) {
+        return column[j] + t * (column[j + 1] - column[j]);
+      };
+
+      Rotation2d heading0{samples.thetacos[j], samples.thetasin[j]};
+      Rotation2d heading1{samples.thetacos[j + 1], samples.thetasin[j + 1]};
+      double heading = heading0.Radians() +
+                       t * (heading1 - heading0).Radians() +
+                       progress * headingError;
+
+      auto translation =
+          start.Translation() +
+          (Translation2d{lerp(samples.x), lerp(samples.y)} +
+           translationError * progress)
+              .RotateBy(start.Rotation());
+      Rotation2d rotation = start.Rotation() + Rotation2d{heading};
+
+      guess.x[index] = translation.X();
+      guess.y[index] = translation.Y();
+      guess.thetacos[index] = rotation.Cos();
+      guess.thetasin[index] = rotation.Sin();
+
+      auto v = Translation2d{lerp(samples.vx), lerp(samples.vy)}.RotateBy(
+          start.Rotation());
+      guess.vx[index] = v.X();
+      guess.vy[index] = v.Y();
+      guess.omega[index] = lerp(samples.omega);
+
+      auto a = Translation2d{lerp(samples.ax), lerp(samples.ay)}.RotateBy(
+          start.Rotation());
+      guess.ax[index] = a.X();
+      guess.ay[index] = a.Y();
+      guess.alpha[index] = lerp(samples.alpha);
+
+      for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
+        auto F = Translation2d{samples.moduleFX[j][moduleIndex] +
+                                   t * (samples.moduleFX[j + 1][moduleIndex] -
+                                        samples.moduleFX[j][moduleIndex]),
+                               samples.moduleFY[j][moduleIndex] +
+                                   t * (samples.moduleFY[j + 1][moduleIndex] -
+                                        samples.moduleFY[j][moduleIndex])}
+                     .RotateBy(start.Rotation());
+        guess.moduleFX[index][moduleIndex] = F.X();
+        guess.moduleFY[index][moduleIndex] = F.Y();
+      }
+
+      guess.dt[index] = primitive->totalTime / N_sgmt;
+    }
+    if (startIndex == 0) {
+      guess.dt[0] = primitive->totalTime / N_sgmt;
+    }
+  }
+
+  return guess;
+}
+
+void PrimitiveLibrary::BuildTree(size_t begin, size_t end, size_t depth) {
+  if (end - begin <= 1) {
+    return;
+  }
+
+  size_t axis = depth % 3;
+  size_t mid = begin + (end - begin) / 2;
+  std::nth_element(m_tree.begin() + begin, m_tree.begin() + mid,
+                   m_tree.begin() + end, [&](size_t lhs, size_t rhs) {
+                     return m_keys[lhs][axis] < m_keys[rhs][axis];
+                   });
+
+  BuildTree(begin, mid, depth + 1);
+  BuildTree(mid + 1, end, depth + 1);
+}
+
+void PrimitiveLibrary::SearchTree(size_t begin, size_t end, size_t depth,
+                                  const std::array<double, 3>& key,
+                                  size_t& nearest,
+                                  double& nearestSquaredDistance) const {
+  if (begin >= end) {
+    return;
+  }
+
+  size_t mid = begin + (end - begin) / 2;
+  size_t node = m_tree[mid];
+  double squaredDistance = SquaredDistance(key, m_keys[node]);
+  if (squaredDistance < nearestSquaredDistance) {
+    nearest = node;
+    nearestSquaredDistance = squaredDistance;
+  }
+
+  // Search the side of the splitting plane containing the key first, then the
+  // other side only if it could hold something closer
+  size_t axis = depth % 3;
+  double offset = key[axis] - m_keys[node][axis];
+  if (offset < 0.0) {
+    SearchTree(begin, mid, depth + 1, key, nearest, nearestSquaredDistance);
+    if (offset * offset < nearestSquaredDistance) {
+      SearchTree(mid + 1, end, depth + 1, key, nearest,
+                 nearestSquaredDistance);
+    }
+  } else {
+    SearchTree(mid + 1, end, depth + 1, key, nearest, nearestSquaredDistance);
+    if (offset * offset < nearestSquaredDistance) {
+      SearchTree(begin, mid, depth + 1, key, nearest, nearestSquaredDistance);
+    }
+  }
+}
+
+std::array<double, 3> PrimitiveLibrary::Key(const Pose2d& delta) const {
+  return {delta.X(), delta.Y(), m_headingWeight * delta.Rotation().Radians()};
+}
+
+}  // namespace trajopt
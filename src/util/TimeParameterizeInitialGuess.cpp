@@ -0,0 +1,233 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/TimeParameterizeInitialGuess.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "trajopt/drivetrain/detail/SwerveDynamics.hpp"
+#include "trajopt/geometry/BatchGeometry.hpp"
+#include "trajopt/geometry/Rotation2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/**
+ * A rest-to-rest trapezoidal motion profile over a fixed distance.
+ */
+class TrapezoidProfile {
+ public:
+  TrapezoidProfile(double distance, double maxVelocity, double maxAcceleration)
+      : m_distance{distance}, m_maxAcceleration{maxAcceleration} {
+    // If the distance is too short to reach the maximum velocity, the profile
+    // is a triangle instead
+    m_peakVelocity =
+        std::min(maxVelocity, std::sqrt(distance * maxAcceleration));
+    m_accelTime = m_peakVelocity / maxAcceleration;
+    m_accelDistance = 0.5 * m_peakVelocity * m_accelTime;
+    m_totalTime =
+        2.0 * m_accelTime + (distance - 2.0 * m_accelDistance) / m_peakVelocity;
+  }
+
+  double Distance(double time) const {
+    time = std::clamp(time, 0.0, m_totalTime);
+    if (time < m_accelTime) {
+      return 0.5 * m_maxAcceleration * time * time;
+    } else if (time < m_totalTime - m_accelTime) {
+      return m_accelDistance + m_peakVelocity * (time - m_accelTime);
+    } else {
+      double timeLeft = m_totalTime - time;
+      return m_distance - 0.5 * m_maxAcceleration * timeLeft * timeLeft;
+    }
+  }
+
+  double Time(double distance) const {
+    distance = std::clamp(distance, 0.0, m_distance);
+    if (distance < m_accelDistance) {
+      return std::sqrt(2.0 * distance / m_maxAcceleration);
+    } else if (distance < m_distance - m_accelDistance) {
+      return m_accelTime + (distance - m_accelDistance) / m_peakVelocity;
+    } else {
+      return m_totalTime -
+             std::sqrt(2.0 * (m_distance - distance) / m_maxAcceleration);
+    }
+  }
+
+ private:
+  double m_distance;
+  double m_maxAcceleration;
+  double m_peakVelocity;
+  double m_accelTime;
+  double m_accelDistance;
+  double m_totalTime;
+};
+
+}  // namespace
+
+SwerveSolution TimeParameterizeInitialGuess(
+    const SwerveSolution& guess, const SwerveDrivetrain& drivetrain,
+    const std::vector<size_t>& controlIntervalCounts) {
+  const auto& N = controlIntervalCounts;
+  const auto& modules = drivetrain.modules;
+  size_t wptCnt = 1 + N.size();
+  size_t sgmtCnt = N.size();
+  size_t sampTot = GetIndex(N, wptCnt, 0);
+  size_t moduleCnt = modules.size();
+
+  if (moduleCnt == 0 || guess.x.size() != sampTot) {
+    return guess;
+  }
+
+  double maxVelocity = std::numeric_limits<double>::infinity();
+  double maxForce = std::numeric_limits<double>::infinity();
+  double maxModuleRadius = 0.0;
+  double squaredRadiusSum = 0.0;
+  for (const auto& module : modules) {
+    maxVelocity = std::min(maxVelocity, detail::ModuleMaxVelocity(module));
+    maxForce = std::min(maxForce, detail::ModuleMaxForce(module));
+    maxModuleRadius = std::max(maxModuleRadius, module.translation.Norm());
+    squaredRadiusSum += module.translation.SquaredNorm();
+  }
+
+  // Each module's share of the net force is (mass / moduleCnt) a, and its share
+  // of the net torque is (moi / squaredRadiusSum) rα at the farthest module
+  double inertiaPerModule = drivetrain.mass / moduleCnt;
+  if (squaredRadiusSum > 0.0) {
+    inertiaPerModule =
+        std::max(inertiaPerModule, drivetrain.moi / squaredRadiusSum);
+  }
+  double maxAcceleration = maxForce / inertiaPerModule;
+
+  // Distance along the guess, counting the farthest wheel's travel while
+  // rotating, and the unwrapped heading at each sample
+  std::vector<double> distance(sampTot, 0.0);
+  std::vector<double> heading(sampTot, 0.0);
+  heading[0] = Rotation2d{guess.thetacos[0], guess.thetasin[0]}.Radians();
+  for (size_t index = 1; index < sampTot; ++index) {
+    double headingChange =
+        Rotation2d{guess.thetacos[index], guess.thetasin[index]}
+            .RotateBy(-Rotation2d{guess.thetacos[index - 1],
+                                  guess.thetasin[index - 1]})
+            .Radians();
+    heading[index] = heading[index - 1] + headingChange;
+    distance[index] =
+        distance[index - 1] +
+        std::hypot(guess.x[index] - guess.x[index - 1],
+                   guess.y[index] - guess.y[index - 1]) +
+        maxModuleRadius * std::abs(headingChange);
+  }
+
+  if (distance.back() <= 0.0) {
+    return guess;
+  }
+
+  TrapezoidProfile profile{distance.back(), maxVelocity, maxAcceleration};
+
+  SwerveSolution result;
+  result.dt.assign(sampTot, 0.0);
+  result.x.reserve(sampTot);
+  result.y.reserve(sampTot);
+  std::vector<double> resultHeading;
+  resultHeading.reserve(sampTot);
+
+  // Appends the guess's pose at the given distance along it
+  auto appendPose = [&](double s) {
+    auto next = std::upper_bound(distance.begin(), distance.end(), s);
+    size_t index =
+        std::clamp<size_t>(next - distance.begin(), 1, sampTot - 1);
+
+    double span = distance[index] - distance[index - 1];
+    double t = span > 0.0 ? (s - distance[index - 1]) / span : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+
+    double theta =
+        heading[index - 1] + t * (heading[index] - heading[index - 1]);
+    result.x.push_back(guess.x[index - 1] +
+                       t * (guess.x[index] - guess.x[index - 1]));
+    result.y.push_back(guess.y[index - 1] +
+                       t * (guess.y[index] - guess.y[index - 1]));
+    resultHeading.push_back(theta);
+  };
+
+  appendPose(0.0);
+  for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
+    size_t N_sgmt = N.at(sgmtIndex);
+
+    // Waypoint samples stay at the same distance along the guess, so each
+    // segment takes the time the profile spends between its waypoints
+    double startTime =
+        profile.Time(distance[GetIndex(N, sgmtIndex + 1, 0) - 1]);
+    double endTime = profile.Time(distance[GetIndex(N, sgmtIndex + 2, 0) - 1]);
+    double dt_sgmt = (endTime - startTime) / N_sgmt;
+
+    for (size_t sampIndex = 0; sampIndex < N_sgmt; ++sampIndex) {
+      result.dt[GetIndex(N, sgmtIndex + 1, sampIndex)] = dt_sgmt;
+      appendPose(profile.Distance(startTime + (sampIndex + 1) * dt_sgmt));
+    }
+  }
+  if (sgmtCnt > 0) {
+    result.dt[0] = result.dt[1];
+  }
+
+  result.thetacos.resize(sampTot);
+  result.thetasin.resize(sampTot);
+  BatchCosSin(resultHeading, result.thetacos, result.thetasin);
+
+  // Backward differences, matching the generator's kinematics constraints
+  result.vx.assign(sampTot, 0.0);
+  result.vy.assign(sampTot, 0.0);
+  result.omega.assign(sampTot, 0.0);
+  result.ax.assign(sampTot, 0.0);
+  result.ay.assign(sampTot, 0.0);
+  result.alpha.assign(sampTot, 0.0);
+  for (size_t index = 1; index < sampTot; ++index) {
+    double dt = result.dt[index];
+    if (dt <= 0.0) {
+      continue;
+    }
+
+    Rotation2d theta{result.thetacos[index], result.thetasin[index]};
+    Rotation2d lastTheta{result.thetacos[index - 1],
+                         result.thetasin[index - 1]};
+
+    result.vx[index] = (result.x[index] - result.x[index - 1]) / dt;
+    result.vy[index] = (result.y[index] - result.y[index - 1]) / dt;
+    result.omega[index] = theta.RotateBy(-lastTheta).Radians() / dt;
+    result.ax[index] = (result.vx[index] - result.vx[index - 1]) / dt;
+    result.ay[index] = (result.vy[index] - result.vy[index - 1]) / dt;
+    result.alpha[index] = (result.omega[index] - result.omega[index - 1]) / dt;
+  }
+
+  // Split the net force evenly, and produce the net torque with forces
+  // perpendicular to each module's position
+  result.moduleFX.reserve(sampTot);
+  result.moduleFY.reserve(sampTot);
+  for (size_t index = 0; index < sampTot; ++index) {
+    Rotation2d theta{result.thetacos[index], result.thetasin[index]};
+    double tangentialForcePerRadius =
+        squaredRadiusSum > 0.0
+            ? drivetrain.moi * result.alpha[index] / squaredRadiusSum
+            : 0.0;
+
+    auto& moduleFX = result.moduleFX.emplace_back();
+    auto& moduleFY = result.moduleFY.emplace_back();
+    moduleFX.reserve(moduleCnt);
+    moduleFY.reserve(moduleCnt);
+    for (const auto& module : modules) {
+      auto r = module.translation.RotateBy(theta);
+      moduleFX.push_back(drivetrain.mass / moduleCnt * result.ax[index] -
+                         tangentialForcePerRadius * r.Y());
+      moduleFY.push_back(drivetrain.mass / moduleCnt * result.ay[index] +
+                         tangentialForcePerRadius * r.X());
+    }
+  }
+
+  return result;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,263 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/ValidateTrajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "trajopt/constraint/Constraint.hpp"
+#include "trajopt/drivetrain/detail/SwerveDynamics.hpp"
+#include "trajopt/geometry/Pose2.hpp"
+#include "trajopt/geometry/Rotation2.hpp"
+#include "trajopt/geometry/Translation2.hpp"
+#include "trajopt/obstacle/detail/ObstacleConstraints.hpp"
+#include "trajopt/util/TrajoptUtil.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/**
+ * The robot's state at one sample of a solution.
+ */
+struct SampleState {
+  Pose2d pose;
+  Translation2d linearVelocity;
+  double angularVelocity;
+  Translation2d linearAcceleration;
+  double angularAcceleration;
+};
+
+SampleState GetSampleState(const SwerveSolution& solution, size_t index) {
+  return SampleState{
+      {solution.x[index],
+       solution.y[index],
+       {solution.thetacos[index], solution.thetasin[index]}},
+      {solution.vx[index], solution.vy[index]},
+      solution.omega[index],
+      {solution.ax[index], solution.ay[index]},
+      solution.alpha[index]};
+}
+
+double EvaluateConstraint(const Constraint& constraint,
+                          const SampleState& state) {
+  return Evaluate(constraint, state.pose, state.linearVelocity,
+                  state.angularVelocity, state.linearAcceleration,
+                  state.angularAcceleration);
+}
+
+}  // namespace
+
+double TrajectoryValidation::MaxViolation() const {
+  if (samples.empty()) {
+    return totalTime;
+  }
+  return std::max(totalTime, *std::max_element(samples.begin(), samples.end()));
+}
+
+expected<TrajectoryValidation, std::string> ValidateTrajectory(
+    const SwerveSolution& solution, const SwervePath& path,
+    const std::vector<size_t>& controlIntervalCounts) {
+  const auto& N = controlIntervalCounts;
+  size_t wptCnt = 1 + N.size();
+  size_t sgmtCnt = N.size();
+  size_t sampTot = GetIndex(N, wptCnt, 0);
+  size_t moduleCnt = path.drivetrain.modules.size();
+
+  if (path.waypoints.size() != wptCnt) {
+    return unexpected{std::string{
+        "Path waypoint count doesn't match control interval counts"}};
+  }
+  for (const auto* column :
+       {&solution.x, &solution.y, &solution.thetacos, &solution.thetasin,
+        &solution.vx, &solution.vy, &solution.omega, &solution.ax,
+        &solution.ay, &solution.alpha}) {
+    if (column->size() != sampTot) {
+      return unexpected{
+          std::string{"Solution sample count doesn't match path"}};
+    }
+  }
+  if (solution.moduleFX.size() != sampTot ||
+      solution.moduleFY.size() != sampTot) {
+    return unexpected{std::string{"Solution sample count doesn't match path"}};
+  }
+
+  // Generated solutions have one dt per control interval, and initial guesses
+  // have one per sample whose first element is unused
+  if (solution.dt.size() != sampTot - 1 && solution.dt.size() != sampTot) {
+    return unexpected{
+        std::string{"Solution time step count doesn't match path"}};
+  }
+  size_t dtOffset = solution.dt.size() == sampTot ? 0 : 1;
+
+  std::vector<SampleState> states;
+  states.reserve(sampTot);
+  for (size_t index = 0; index < sampTot; ++index) {
+    states.push_back(GetSampleState(solution, index));
+  }
+
+  TrajectoryValidation result;
+  result.moduleVelocity.assign(sampTot, 0.0);
+  result.moduleForce.assign(sampTot, 0.0);
+  result.dynamics.assign(sampTot, 0.0);
+  result.fieldObstacles.assign(sampTot, 0.0);
+  result.kinematics.assign(sampTot, 0.0);
+  result.timeStep.assign(sampTot, 0.0);
+  result.samples.assign(sampTot, 0.0);
+
+  // Check module limits and dynamics
+  for (size_t index = 0; index < sampTot; ++index) {
+    const auto& state = states[index];
+    const auto& moduleFX = solution.moduleFX[index];
+    const auto& moduleFY = solution.moduleFY[index];
+    if (moduleFX.size() != moduleCnt || moduleFY.size() != moduleCnt) {
+      return unexpected{
+          std::string{"Solution module count doesn't match drivetrain"}};
+    }
+
+    const auto& theta = state.pose.Rotation();
+    auto vWrtRobot = state.linearVelocity.RotateBy(-theta);
+
+    double Fx_net = 0.0;
+    double Fy_net = 0.0;
+    double tau_net = 0.0;
+    for (size_t moduleIndex = 0; moduleIndex < moduleCnt; ++moduleIndex) {
+      const auto& module = path.drivetrain.modules[moduleIndex];
+      Translation2d F{moduleFX[moduleIndex], moduleFY[moduleIndex]};
+
+      Fx_net += F.X();
+      Fy_net += F.Y();
+      tau_net += detail::ModuleTorque(module, theta, F);
+
+      auto vWheelWrtRobot =
+          detail::ModuleVelocity(module, vWrtRobot, state.angularVelocity);
+      result.moduleVelocity[index] =
+          std::max(result.moduleVelocity[index],
+                   vWheelWrtRobot.Norm() - detail::ModuleMaxVelocity(module));
+      result.moduleForce[index] = std::max(
+          result.moduleForce[index], F.Norm() - detail::ModuleMaxForce(module));
+    }
+
+    result.dynamics[index] = std::max(
+        {std::abs(Fx_net - path.drivetrain.mass * state.linearAcceleration.X()),
+         std::abs(Fy_net - path.drivetrain.mass * state.linearAcceleration.Y()),
+         std::abs(tau_net - path.drivetrain.moi * state.angularAcceleration)});
+
+    result.samples[index] =
+        std::max({result.moduleVelocity[index], result.moduleForce[index],
+                  result.dynamics[index]});
+  }
+
+  // Check kinematics and time step bounds between consecutive samples
+  double minWidth = detail::MinModuleSpacing(path.drivetrain);
+  double totalTime = 0.0;
+  for (size_t index = 1; index < sampTot; ++index) {
+    const auto& state = states[index];
+    const auto& lastState = states[index - 1];
+    double dt = solution.dt[index - dtOffset];
+    totalTime += dt;
+
+    result.kinematics[index] = std::max(
+        {(lastState.pose.Translation() + state.linearVelocity * dt -
+          state.pose.Translation())
+             .Norm(),
+         std::abs((state.pose.Rotation() - lastState.pose.Rotation() -
+                   Rotation2d{state.angularVelocity * dt})
+                      .Radians()),
+         (lastState.linearVelocity + state.linearAcceleration * dt -
+          state.linearVelocity)
+             .Norm(),
+         std::abs(lastState.angularVelocity + state.angularAcceleration * dt -
+                  state.angularVelocity)});
+
+    result.timeStep[index] = std::max(0.0, -dt);
+    for (const auto& module : path.drivetrain.modules) {
+      result.timeStep[index] =
+          std::max(result.timeStep[index],
+                   dt * detail::ModuleMaxVelocity(module) - minWidth);
+    }
+
+    result.samples[index] =
+        std::max({result.samples[index], result.kinematics[index],
+                  result.timeStep[index]});
+  }
+
+  if (path.totalTime) {
+    result.totalTime = std::abs(totalTime - *path.totalTime);
+  }
+  if (path.maxTotalTime) {
+    result.totalTime =
+        std::max(result.totalTime, totalTime - *path.maxTotalTime);
+  }
+
+  // Check waypoint constraints at the last sample of each waypoint
+  for (size_t wptIndex = 0; wptIndex < wptCnt; ++wptIndex) {
+    const auto& constraints = path.waypoints[wptIndex].waypointConstraints;
+
+    // First index of next wpt - 1
+    size_t index = GetIndex(N, wptIndex + 1, 0) - 1;
+
+    for (size_t constraintIndex = 0; constraintIndex < constraints.size();
+         ++constraintIndex) {
+      double violation =
+          EvaluateConstraint(constraints[constraintIndex], states[index]);
+      result.waypointConstraints.push_back(
+          {wptIndex, constraintIndex, index, violation});
+      result.samples[index] = std::max(result.samples[index], violation);
+    }
+  }
+
+  // Check segment constraints at every sample of each segment
+  for (size_t sgmtIndex = 0; sgmtIndex < sgmtCnt; ++sgmtIndex) {
+    size_t wptIndex = sgmtIndex + 1;
+    const auto& constraints = path.waypoints[wptIndex].segmentConstraints;
+
+    size_t startIndex = GetIndex(N, sgmtIndex + 1, 0);
+    size_t endIndex = GetIndex(N, sgmtIndex + 2, 0);
+
+    for (size_t constraintIndex = 0; constraintIndex < constraints.size();
+         ++constraintIndex) {
+      ConstraintViolation worst{wptIndex, constraintIndex, startIndex, 0.0};
+      for (size_t index = startIndex; index < endIndex; ++index) {
+        double violation =
+            EvaluateConstraint(constraints[constraintIndex], states[index]);
+        if (violation > worst.violation) {
+          worst.sampleIndex = index;
+          worst.violation = violation;
+        }
+        result.samples[index] = std::max(result.samples[index], violation);
+      }
+      result.segmentConstraints.push_back(worst);
+    }
+
+    // Check the field's obstacles near the segment the way the generator
+    // culls them, but around the solution instead of the initial guess, so
+    // every obstacle the bumpers come near is checked
+    if (path.field && path.waypoints[wptIndex].fieldCullDistance) {
+      std::vector<Constraint> fieldConstraints;
+      size_t count = endIndex - startIndex + 1;
+      detail::AppendFieldConstraints(
+          *path.field, path.bumpers,
+          *path.waypoints[wptIndex].fieldCullDistance,
+          std::span{solution.x}.subspan(startIndex - 1, count),
+          std::span{solution.y}.subspan(startIndex - 1, count),
+          fieldConstraints);
+
+      for (const auto& constraint : fieldConstraints) {
+        for (size_t index = startIndex; index < endIndex; ++index) {
+          double violation = EvaluateConstraint(constraint, states[index]);
+          result.fieldObstacles[index] =
+              std::max(result.fieldObstacles[index], violation);
+          result.samples[index] = std::max(result.samples[index], violation);
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+}  // namespace trajopt
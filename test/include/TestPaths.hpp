@@ -0,0 +1,117 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include <trajopt/constraint/AngularVelocityMaxMagnitudeConstraint.hpp>
+#include <trajopt/constraint/LinearVelocityMaxMagnitudeConstraint.hpp>
+#include <trajopt/drivetrain/SwerveDrivetrain.hpp>
+#include <trajopt/geometry/Pose2.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+namespace trajopt::test {
+
+/**
+ * Returns the drivetrain the tests use: 45 kg, with four modules at the
+ * corners of a 1.2 m square.
+ */
+inline SwerveDrivetrain Drivetrain() {
+  return {.mass = 45,
+          .moi = 6,
+          .modules = {{{+0.6, +0.6}, 0.04, 70, 2},
+                      {{+0.6, -0.6}, 0.04, 70, 2},
+                      {{-0.6, +0.6}, 0.04, 70, 2},
+                      {{-0.6, -0.6}, 0.04, 70, 2}}};
+}
+
+/**
+ * Returns a path for the test drivetrain through the given poses.
+ *
+ * @param poses The pose at each waypoint.
+ * @param controlIntervalCounts The control interval count of each segment.
+ */
+inline SwervePathBuilder PosePath(const std::vector<Pose2d>& poses,
+                                  std::vector<size_t> controlIntervalCounts) {
+  SwervePathBuilder path;
+  path.SetDrivetrain(Drivetrain());
+  for (size_t index = 0; index < poses.size(); ++index) {
+    path.PoseWpt(index, poses[index].X(), poses[index].Y(),
+                 poses[index].Rotation().Radians());
+  }
+  path.ControlIntervalCounts(std::move(controlIntervalCounts));
+  return path;
+}
+
+/**
+ * Returns the single-segment path most tests generate: 20 control intervals
+ * from the origin to (2 m, 1 m) at 0.5 rad.
+ */
+inline SwervePathBuilder ShortPath() {
+  return PosePath({{0.0, 0.0, 0.0}, {2.0, 1.0, 0.5}}, {20});
+}
+
+/**
+ * Returns a path with two segments of 10 control intervals each, from the
+ * origin through (1 m, 1 m) to (2 m, 0 m) at 0.5 rad.
+ */
+inline SwervePathBuilder TwoSegmentPath() {
+  return PosePath({{0.0, 0.0, 0.0}, {1.0, 1.0, 0.0}, {2.0, 0.0, 0.5}},
+                  {10, 10});
+}
+
+/**
+ * Makes the robot stop at a waypoint. A pose waypoint the robot stops at is
+ * pinned.
+ *
+ * @param path The path.
+ * @param wptIndex The waypoint's index.
+ */
+inline void StopAt(SwervePathBuilder& path, size_t wptIndex) {
+  path.WptConstraint(wptIndex, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.WptConstraint(wptIndex, AngularVelocityMaxMagnitudeConstraint{0.0});
+}
+
+/**
+ * Returns a path with two segments of 10 control intervals each that stops at
+ * the origin, at (2 m, 0 m), and at (2 m, 2 m), so its middle waypoint is
+ * pinned.
+ */
+inline SwervePathBuilder CornerPath() {
+  auto path = PosePath({{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {2.0, 2.0, 0.0}},
+                       {10, 10});
+  for (size_t wptIndex = 0; wptIndex < 3; ++wptIndex) {
+    StopAt(path, wptIndex);
+  }
+  return path;
+}
+
+/**
+ * Returns a path with two segments of 10 control intervals each from rest at
+ * the origin, through (2 m, 1 m) at any heading, to rest at (4 m, 0 m).
+ */
+inline SwervePathBuilder TranslationPath() {
+  SwervePathBuilder path;
+  path.SetDrivetrain(Drivetrain());
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.TranslationWpt(1, 2.0, 1.0, 0.0);
+  path.PoseWpt(2, 4.0, 0.0, 0.0);
+  path.WptConstraint(0, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.WptConstraint(2, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.ControlIntervalCounts({10, 10});
+  return path;
+}
+
+/**
+ * Returns a path with segments of 20 and 30 control intervals along the x axis
+ * to (8 m, 0 m), turning to 1 rad.
+ */
+inline SwervePathBuilder StraightPath() {
+  return PosePath({{0.0, 0.0, 0.0}, {4.0, 0.0, 0.5}, {8.0, 0.0, 1.0}},
+                  {20, 30});
+}
+
+}  // namespace trajopt::test
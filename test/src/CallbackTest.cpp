@@ -0,0 +1,57 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <limits>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("Callback - Rate", "[Callback]") {
+  auto path = trajopt::test::ShortPath();
+
+  int callCount = 0;
+  path.AddIntermediateCallback(
+      [&](trajopt::SwerveSolution&, int64_t) { ++callCount; });
+
+  // An unlimited rate calls the callbacks on every iteration
+  path.SetCallbackRate(std::numeric_limits<double>::infinity());
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(callCount == solution->iterations);
+}
+
+TEST_CASE("Callback - Thread", "[Callback]") {
+  auto path = trajopt::test::ShortPath();
+
+  // Callbacks run off the solver's thread, and every update queued before the
+  // solve ends is delivered
+  int callCount = 0;
+  bool onSolverThread = false;
+  auto solverThread = std::this_thread::get_id();
+  path.AddIntermediateCallback([&](trajopt::SwerveSolution&, int64_t) {
+    ++callCount;
+    onSolverThread |= std::this_thread::get_id() == solverThread;
+  });
+  path.SetCallbackRate(std::numeric_limits<double>::infinity());
+  path.SetCallbackThread(true);
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(callCount > 0);
+  CHECK(callCount <= solution->iterations);
+  CHECK_FALSE(onSolverThread);
+
+  // Every update is either delivered or replaced by a newer one
+  auto counters = generator.GetCallbackCounters();
+  CHECK(counters.delivered == static_cast<uint64_t>(callCount));
+  CHECK(counters.delivered + counters.dropped ==
+        static_cast<uint64_t>(solution->iterations));
+}
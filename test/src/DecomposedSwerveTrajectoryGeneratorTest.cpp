@@ -0,0 +1,107 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/DecomposedSwerveTrajectoryGenerator.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/util/ValidateTrajectory.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("DecomposedSwerveTrajectoryGenerator - Pinned waypoints",
+          "[DecomposedSwerveTrajectoryGenerator]") {
+  auto path = trajopt::test::CornerPath();
+  CHECK(trajopt::IsWaypointPinned(path.GetPath(), 1));
+
+  // A waypoint the robot drives through isn't pinned
+  trajopt::SwervePathBuilder moving;
+  moving.PoseWpt(0, 0.0, 0.0, 0.0);
+  moving.WptConstraint(0, trajopt::LinearVelocityMaxMagnitudeConstraint{1.0});
+  moving.WptConstraint(0, trajopt::AngularVelocityMaxMagnitudeConstraint{0.0});
+  CHECK_FALSE(trajopt::IsWaypointPinned(moving.GetPath(), 0));
+}
+
+TEST_CASE("DecomposedSwerveTrajectoryGenerator - Stitched solution",
+          "[DecomposedSwerveTrajectoryGenerator]") {
+  trajopt::DecomposedSwerveTrajectoryGenerator generator{
+      trajopt::test::CornerPath(), {1}};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+
+  // One sample per sample of the whole path, and one dt per control interval
+  CHECK(solution->x.size() == 21);
+  CHECK(solution->moduleFX.size() == 21);
+  CHECK(solution->dt.size() == 20);
+
+  // Each piece takes at least one iteration, and the stitched solution counts
+  // them all
+  CHECK(solution->iterations >= 2);
+
+  // The pieces meet at the split waypoint
+  CHECK(solution->x[10] == Catch::Approx(2.0));
+  CHECK(solution->y[10] == Catch::Approx(0.0).margin(1e-6));
+}
+
+TEST_CASE("DecomposedSwerveTrajectoryGenerator - Pinned and consensus splits",
+          "[DecomposedSwerveTrajectoryGenerator]") {
+  // The first piece ends at a pinned waypoint, so it's solved once, while the
+  // other two have to agree on the state at the waypoint they share
+  auto path = trajopt::test::PosePath(
+      {{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {2.0, 2.0, 0.0}, {0.0, 2.0, 0.0}},
+      {10, 10, 10});
+  trajopt::test::StopAt(path, 1);
+
+  trajopt::DecomposedSwerveTrajectoryGenerator generator{path, {1, 2}};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(solution->x.size() == 31);
+  CHECK(solution->dt.size() == 30);
+  CHECK(solution->x[10] == Catch::Approx(2.0));
+  CHECK(solution->x[20] == Catch::Approx(2.0));
+  CHECK(solution->y[20] == Catch::Approx(2.0));
+
+  // The stitched solution drops the last piece's first sample, so its second
+  // sample only integrates from the second piece's last if they agreed on the
+  // velocities at the consensus split
+  double dt = solution->dt[20];
+  CHECK(solution->vx[20] + solution->ax[21] * dt ==
+        Catch::Approx(solution->vx[21]).margin(1e-6));
+  CHECK(solution->vy[20] + solution->ay[21] * dt ==
+        Catch::Approx(solution->vy[21]).margin(1e-6));
+  CHECK(solution->omega[20] + solution->alpha[21] * dt ==
+        Catch::Approx(solution->omega[21]).margin(1e-6));
+  CHECK(solution->thetacos[20] == Catch::Approx(1.0));
+  CHECK(solution->thetasin[20] == Catch::Approx(0.0).margin(1e-6));
+
+  // The stitched solution's kinematics are consistent throughout
+  auto validation = trajopt::ValidateTrajectory(
+      *solution, path.GetPath(), path.GetControlIntervalCounts());
+  REQUIRE(validation.has_value());
+  CHECK(*std::max_element(validation->kinematics.begin(),
+                          validation->kinematics.end()) <= 1e-4);
+}
+
+TEST_CASE("DecomposedSwerveTrajectoryGenerator - Invalid split",
+          "[DecomposedSwerveTrajectoryGenerator]") {
+  trajopt::DecomposedSwerveTrajectoryGenerator generator{
+      trajopt::test::CornerPath(), {2}};
+  CHECK_FALSE(generator.Generate().has_value());
+}
+
+TEST_CASE("DecomposedSwerveTrajectoryGenerator - Automatic split",
+          "[DecomposedSwerveTrajectoryGenerator]") {
+  // The generator splits at the pinned waypoint by itself, and the solution
+  // has the same form as an unsplit one
+  trajopt::SwerveTrajectoryGenerator generator{trajopt::test::CornerPath()};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+
+  CHECK(solution->x.size() == 21);
+  CHECK(solution->moduleFX.size() == 21);
+  CHECK(solution->dt.size() == 20);
+  CHECK(solution->x[10] == Catch::Approx(2.0));
+}
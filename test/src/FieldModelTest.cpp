@@ -0,0 +1,108 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/geometry/Rotation2.hpp>
+#include <trajopt/geometry/Translation2.hpp>
+#include <trajopt/obstacle/FieldModel.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("FieldModel - Obstacles near", "[FieldModel]") {
+  trajopt::FieldModel field{
+      {trajopt::Obstacle{.safetyDistance = 0.1, .points = {{1.0, 1.0}}},
+       trajopt::Obstacle{.safetyDistance = 0.0,
+                         .points = {{4.0, 0.0}, {6.0, 0.0}, {5.0, 2.0}}},
+       trajopt::Obstacle{.safetyDistance = 0.5, .points = {{10.0, 5.0}}}}};
+
+  // Bounds are grown by the safety distance
+  CHECK(field.GetBounds(0).min.X() == 0.9);
+  CHECK(field.GetBounds(2).max.Y() == 5.5);
+
+  using Bounds = trajopt::FieldModel::Bounds;
+  CHECK(field.ObstaclesNear(Bounds{{0.0, 0.0}, {2.0, 2.0}}) ==
+        std::vector<size_t>{0});
+  CHECK(field.ObstaclesNear(Bounds{{0.0, 0.0}, {5.0, 5.0}}) ==
+        std::vector<size_t>{0, 1});
+  CHECK(field.ObstaclesNear(Bounds{{9.6, 4.6}, {20.0, 20.0}}) ==
+        std::vector<size_t>{2});
+  CHECK(field.ObstaclesNear(Bounds{{-5.0, -5.0}, {-1.0, -1.0}}).empty());
+  CHECK(field.ObstaclesNear(Bounds{{1.5, 1.5}, {3.5, 3.5}}).empty());
+
+  // A box around the whole field finds every obstacle once
+  CHECK(field.ObstaclesNear(Bounds{{-100.0, -100.0}, {100.0, 100.0}}) ==
+        std::vector<size_t>{0, 1, 2});
+
+  // Every bumper edge avoids every obstacle corner and every obstacle edge,
+  // including the closing one, avoids every bumper corner
+  std::vector<trajopt::Constraint> constraints;
+  field.AppendConstraints(
+      trajopt::Bumpers{.safetyDistance = 0.1,
+                       .points = {{0.3, 0.3}, {-0.3, 0.3}, {-0.3, -0.3}}},
+      1, constraints);
+  CHECK(constraints.size() == 3 * 3 + 3 * 3);
+}
+
+TEST_CASE("FieldModel - Obstacles without points", "[FieldModel]") {
+  using Bounds = trajopt::FieldModel::Bounds;
+  Bounds everywhere{{-100.0, -100.0}, {100.0, 100.0}};
+
+  // Obstacles without points are never near anything, and don't stretch the
+  // grid over infinite bounds
+  trajopt::FieldModel field{
+      {trajopt::Obstacle{.safetyDistance = 0.1, .points = {}},
+       trajopt::Obstacle{.safetyDistance = 0.1, .points = {{1.0, 1.0}}}}};
+  CHECK(field.ObstaclesNear(everywhere) == std::vector<size_t>{1});
+
+  trajopt::FieldModel empty{
+      {trajopt::Obstacle{.safetyDistance = 0.1, .points = {}}}};
+  CHECK(empty.ObstaclesNear(everywhere).empty());
+}
+
+TEST_CASE("FieldModel - Shared by paths", "[FieldModel]") {
+  auto field = std::make_shared<const trajopt::FieldModel>(
+      std::vector{trajopt::Obstacle{.safetyDistance = 0.2,
+                                    .points = {{1.5, 0.5}}},
+                  trajopt::Obstacle{.safetyDistance = 0.2,
+                                    .points = {{20.0, 20.0}}}});
+
+  for (double y : {1.0, 1.5}) {
+    auto path =
+        trajopt::test::PosePath({{0.0, 0.0, 0.0}, {3.0, y, 0.0}}, {20});
+    path.AddBumpers(trajopt::Bumpers{.safetyDistance = 0.1,
+                                     .points = {{+0.3, +0.3},
+                                                {-0.3, +0.3},
+                                                {-0.3, -0.3},
+                                                {+0.3, -0.3}}});
+    path.SetField(field);
+    path.SgmtFieldObstacles(0, 1, 1.0);
+
+    // The field's constraints aren't copied into the path
+    CHECK(path.GetPath().waypoints.at(1).segmentConstraints.empty());
+
+    trajopt::SwerveTrajectoryGenerator generator{path};
+    auto solution = generator.Generate();
+    REQUIRE(solution.has_value());
+
+    // The bumpers keep both safety distances from the obstacle at (1.5, 0.5)
+    for (size_t index = 0; index < solution->x.size(); ++index) {
+      trajopt::Rotation2d heading{solution->thetacos[index],
+                                  solution->thetasin[index]};
+      auto obstacle =
+          (trajopt::Translation2d{1.5, 0.5} -
+           trajopt::Translation2d{solution->x[index], solution->y[index]})
+              .RotateBy(-heading);
+      double distance = std::hypot(std::max(std::abs(obstacle.X()) - 0.3, 0.0),
+                                   std::max(std::abs(obstacle.Y()) - 0.3, 0.0));
+      CHECK(distance >= 0.3 - 1e-4);
+    }
+  }
+
+  CHECK(field.use_count() == 1);
+}
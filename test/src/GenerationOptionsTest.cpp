@@ -0,0 +1,115 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <numeric>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/GenerationOptions.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("GenerationOptions - Presets", "[GenerationOptions]") {
+  constexpr auto preview = trajopt::GenerationOptions::Preview();
+  constexpr auto defaults = trajopt::GenerationOptions{};
+  constexpr auto exported = trajopt::GenerationOptions::Export();
+
+  CHECK(preview.tolerance > defaults.tolerance);
+  CHECK(exported.tolerance < defaults.tolerance);
+  CHECK(preview.maxIterations < defaults.maxIterations);
+  CHECK(preview.mode == trajopt::GenerationMode::kOptimal);
+}
+
+TEST_CASE("GenerationOptions - Generate", "[GenerationOptions]") {
+  auto path = trajopt::test::ShortPath();
+
+  auto options = trajopt::GenerationOptions::Preview();
+  SECTION("Optimal") {}
+  SECTION("Feasible") {
+    options.mode = trajopt::GenerationMode::kFeasible;
+  }
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate(options);
+  REQUIRE(solution.has_value());
+  CHECK(solution->x.size() == 21);
+  CHECK(solution->dt.size() == 20);
+}
+
+TEST_CASE("GenerationOptions - Feasible then optimal", "[GenerationOptions]") {
+  auto path = trajopt::test::ShortPath();
+  auto fresh = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(fresh.has_value());
+
+  // An optimal solve after a feasible one minimizes the path's objective again
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  trajopt::GenerationOptions options;
+  options.mode = trajopt::GenerationMode::kFeasible;
+  REQUIRE(generator.Generate(options).has_value());
+
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(std::accumulate(solution->dt.begin(), solution->dt.end(), 0.0) ==
+        Catch::Approx(std::accumulate(fresh->dt.begin(), fresh->dt.end(), 0.0))
+            .epsilon(1e-3));
+}
+
+TEST_CASE("GenerationOptions - Anytime", "[GenerationOptions]") {
+  auto path = trajopt::test::ShortPath();
+
+  // A solve that converges isn't flagged, even in anytime mode
+  trajopt::GenerationOptions options;
+  options.anytime = true;
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate(options);
+  REQUIRE(solution.has_value());
+  CHECK_FALSE(solution->suboptimal);
+  CHECK(solution->constraintViolation == 0.0);
+}
+
+TEST_CASE("GenerationOptions - Anytime budget", "[GenerationOptions]") {
+  auto path = trajopt::test::ShortPath();
+
+  SECTION("Minimum time") {}
+  SECTION("Minimum force") {
+    path.SetObjective(trajopt::MinimumForceObjective{});
+    path.TotalTime(3.0);
+  }
+
+  // Running out of iterations returns the best iterate within the tolerance
+  // instead of failing
+  trajopt::GenerationOptions options;
+  options.maxIterations = 1;
+  options.anytime = true;
+  options.anytimeTolerance = 1e3;
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate(options);
+  REQUIRE(solution.has_value());
+  CHECK(solution->suboptimal);
+  CHECK(solution->constraintViolation <= options.anytimeTolerance);
+  CHECK(solution->iterations == 1);
+
+  // Without anytime mode the same budget is a failure
+  options.anytime = false;
+  CHECK_FALSE(generator.Generate(options).has_value());
+}
+
+TEST_CASE("GenerationOptions - Anytime time bounds", "[GenerationOptions]") {
+  auto path = trajopt::test::ShortPath();
+
+  // A total time this long needs time steps far longer than the wheels allow,
+  // so no iterate is within the tolerance of both bounds
+  path.TotalTime(1e4);
+
+  trajopt::GenerationOptions options;
+  options.maxIterations = 1;
+  options.anytime = true;
+  options.anytimeTolerance = 1e3;
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  CHECK_FALSE(generator.Generate(options).has_value());
+}
@@ -0,0 +1,88 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/GenerationOptions.hpp>
+#include <trajopt/GenerationPool.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/util/Cancellation.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("GenerationPool - Concurrent jobs", "[GenerationPool]") {
+  std::atomic<int> doneCount = 0;
+  std::vector<std::shared_ptr<trajopt::GenerationJob>> jobs;
+
+  {
+    trajopt::GenerationPool pool{2};
+    for (int i = 0; i < 6; ++i) {
+      jobs.push_back(pool.Submit(trajopt::test::ShortPath()));
+      jobs.back()->OnDone([&] { ++doneCount; });
+    }
+
+    for (auto& job : jobs) {
+      const auto& solution = job->Wait();
+      REQUIRE(solution.has_value());
+      CHECK(solution->x.size() == 21);
+      CHECK(job->IsDone());
+    }
+  }
+
+  // Done callbacks run after the result is set, so they're only known to have
+  // run once the pool's threads have exited
+  CHECK(doneCount == 6);
+
+  // A callback set after the job finished runs right away
+  bool called = false;
+  jobs.front()->OnDone([&] { called = true; });
+  CHECK(called);
+}
+
+TEST_CASE("GenerationPool - Cancellation", "[GenerationPool]") {
+  // A canceled job fails without affecting the others
+  trajopt::GenerationPool pool{1};
+  auto first = pool.Submit(trajopt::test::ShortPath());
+  auto canceled = pool.Submit(trajopt::test::ShortPath());
+  canceled->Cancel();
+  auto last = pool.Submit(trajopt::test::ShortPath());
+
+  CHECK(first->Wait().has_value());
+  CHECK_FALSE(canceled->Wait().has_value());
+  CHECK(last->Wait().has_value());
+
+  // The per-generation flag stops a generator directly too
+  std::atomic<bool> cancellation = true;
+  trajopt::GenerationOptions options;
+  options.cancellation = &cancellation;
+  trajopt::SwerveTrajectoryGenerator generator{trajopt::test::ShortPath()};
+  CHECK_FALSE(generator.Generate(options).has_value());
+}
+
+TEST_CASE("GenerationPool - Cancel all", "[GenerationPool]") {
+  // Canceling every generation stops the ones running at the time
+  auto path = trajopt::test::ShortPath();
+  path.AddIntermediateCallback([](trajopt::SwerveSolution&, int64_t) {
+    ++trajopt::GetCancellationFlag();
+  });
+  CHECK_FALSE(trajopt::SwerveTrajectoryGenerator{path}.Generate().has_value());
+
+  // Generations started afterward aren't canceled, and starting them doesn't
+  // undo a cancellation meant for another one
+  trajopt::GenerationPool pool{1};
+  auto job = pool.Submit(trajopt::test::ShortPath());
+  CHECK(job->Wait().has_value());
+}
+
+TEST_CASE("GenerationPool - Pinned waypoints", "[GenerationPool]") {
+  // A path with a pinned waypoint is solved whole on the worker thread
+  auto path = trajopt::test::CornerPath();
+
+  trajopt::GenerationPool pool{1};
+  const auto& solution = pool.Submit(path)->Wait();
+  REQUIRE(solution.has_value());
+  CHECK(solution->x.size() == 21);
+}
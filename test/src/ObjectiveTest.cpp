@@ -0,0 +1,85 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+#include <numeric>
+#include <variant>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/DecomposedSwerveTrajectoryGenerator.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("Objective - Generate", "[Objective]") {
+  auto path = trajopt::test::TwoSegmentPath();
+  CHECK(std::holds_alternative<trajopt::MinimumTimeObjective>(
+      path.GetPath().objective));
+
+  SECTION("Minimum time") {}
+  SECTION("Minimum force") {
+    path.SetObjective(trajopt::MinimumForceObjective{});
+    path.MaxTotalTime(10.0);
+  }
+  SECTION("Time and jerk") {
+    path.SetObjective(trajopt::TimeAndJerkObjective{.jerkWeight = 1e-2});
+  }
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(solution->x.size() == 21);
+  CHECK(solution->iterations > 0);
+}
+
+TEST_CASE("Objective - Total time", "[Objective]") {
+  auto path = trajopt::test::TwoSegmentPath();
+  path.SetObjective(trajopt::MinimumForceObjective{});
+  path.TotalTime(4.0);
+  REQUIRE(path.GetPath().totalTime == 4.0);
+  CHECK_FALSE(path.GetPath().maxTotalTime.has_value());
+
+  // Slices keep the objective, but total time applies to the whole path
+  auto slice = path.Slice(0, 1);
+  CHECK(std::holds_alternative<trajopt::MinimumForceObjective>(
+      slice.GetPath().objective));
+  CHECK_FALSE(slice.GetPath().totalTime.has_value());
+
+  // The trajectory takes exactly the total time
+  auto solution = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(std::accumulate(solution->dt.begin(), solution->dt.end(), 0.0) ==
+        Catch::Approx(4.0));
+
+  // Total time couples the segments, so the path can't be split
+  trajopt::DecomposedSwerveTrajectoryGenerator generator{path, {1}};
+  CHECK_FALSE(generator.Generate().has_value());
+}
+
+TEST_CASE("Objective - Time and jerk", "[Objective]") {
+  // Sum of the squared changes in acceleration between samples
+  auto jerkPenalty = [](const trajopt::SwerveSolution& solution) {
+    double penalty = 0.0;
+    for (size_t index = 2; index < solution.ax.size(); ++index) {
+      double dax = solution.ax[index] - solution.ax[index - 1];
+      double day = solution.ay[index] - solution.ay[index - 1];
+      double dalpha = solution.alpha[index] - solution.alpha[index - 1];
+      penalty += dax * dax + day * day + dalpha * dalpha;
+    }
+    return penalty;
+  };
+
+  auto path = trajopt::test::TwoSegmentPath();
+  auto minimumTime = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(minimumTime.has_value());
+
+  // Penalizing jerk smooths the accelerations at the cost of some time
+  path.SetObjective(trajopt::TimeAndJerkObjective{.jerkWeight = 1e-2});
+  auto smooth = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(smooth.has_value());
+  CHECK(jerkPenalty(*smooth) < jerkPenalty(*minimumTime));
+  CHECK(std::accumulate(smooth->dt.begin(), smooth->dt.end(), 0.0) >=
+        std::accumulate(minimumTime->dt.begin(), minimumTime->dt.end(), 0.0));
+}
@@ -0,0 +1,70 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <numeric>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/RecedingHorizonSwerveTrajectoryGenerator.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("RecedingHorizonSwerveTrajectoryGenerator - Replan",
+          "[RecedingHorizonSwerveTrajectoryGenerator]") {
+  auto path = trajopt::test::TranslationPath();
+  auto reference = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(reference.has_value());
+  double totalTime =
+      std::accumulate(reference->dt.begin(), reference->dt.end(), 0.0);
+
+  trajopt::RecedingHorizonSwerveTrajectoryGenerator replanner{path,
+                                                              *reference};
+
+  // Bumped sideways three quarters of the way through the first segment
+  double firstSgmtTime = std::accumulate(reference->dt.begin(),
+                                         reference->dt.begin() + 10, 0.0);
+  trajopt::HolonomicTrajectorySample measured{
+      0.75 * firstSgmtTime, reference->x[8], reference->y[8] + 0.05,
+      0.0,                  reference->vx[8], reference->vy[8],
+      0.0};
+
+  auto replanned = replanner.Replan(measured);
+  REQUIRE(replanned.has_value());
+
+  // The replanned trajectory covers the rest of the first segment and all of
+  // the second, starting at the measured state
+  CHECK(replanned->x.size() == 21);
+  CHECK(replanned->dt.size() == 20);
+  CHECK(replanned->x.front() == Catch::Approx(measured.x));
+  CHECK(replanned->y.front() == Catch::Approx(measured.y));
+  CHECK(replanner.Plan().x.size() == 21);
+
+  // Past the end of the plan, there's nothing left to replan
+  measured.timestamp = 2.0 * totalTime;
+  CHECK_FALSE(replanner.Replan(measured).has_value());
+}
+
+TEST_CASE("RecedingHorizonSwerveTrajectoryGenerator - Total time",
+          "[RecedingHorizonSwerveTrajectoryGenerator]") {
+  auto path = trajopt::test::TranslationPath();
+  path.SetObjective(trajopt::MinimumForceObjective{});
+  path.TotalTime(6.0);
+  auto reference = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(reference.has_value());
+
+  trajopt::RecedingHorizonSwerveTrajectoryGenerator replanner{path,
+                                                              *reference};
+
+  // The replanned trajectory takes what's left of the path's total time
+  double time =
+      std::accumulate(reference->dt.begin(), reference->dt.begin() + 5, 0.0);
+  trajopt::HolonomicTrajectorySample measured{
+      time, reference->x[5], reference->y[5], 0.0, reference->vx[5],
+      reference->vy[5], 0.0};
+  auto replanned = replanner.Replan(measured);
+  REQUIRE(replanned.has_value());
+  CHECK(std::accumulate(replanned->dt.begin(), replanned->dt.end(), 0.0) ==
+        Catch::Approx(6.0 - time));
+}
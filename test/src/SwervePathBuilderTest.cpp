@@ -5,7 +5,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <trajopt/path/SwervePathBuilder.hpp>
 
-TEST_CASE("SwervePathBuilder - Linear initial guess", "[SwervePathBuilder]") {
+TEST_CASE("SwervePathBuilder - Spline initial guess", "[SwervePathBuilder]") {
   using namespace trajopt;
 
   trajopt::SwervePathBuilder path;
@@ -20,7 +20,44 @@ TEST_CASE("SwervePathBuilder - Linear initial guess", "[SwervePathBuilder]") {
   path.ControlIntervalCounts({3, 2});
 
   std::vector<double> result = path.CalculateInitialGuess().x;
-  std::vector<double> expected = {0.0, 1.0, 2.0, 1.0, 3.0, 5.0};
+  REQUIRE(result.size() == 6);
+
+  // The spline passes through every guess point
+  CHECK(result[0] == 0.0);
+  CHECK(result[1] == 1.0);
+  CHECK(result[2] == 2.0);
+  CHECK(result[3] == 1.0);
+  CHECK(result[5] == 5.0);
+
+  // Between guess points it bends smoothly instead of following straight lines
+  CHECK(result[4] > 1.0);
+  CHECK(result[4] < 3.0);
+}
+
+TEST_CASE("SwervePathBuilder - Slice", "[SwervePathBuilder]") {
+  using namespace trajopt;
 
-  CHECK(result == expected);
+  trajopt::SwervePathBuilder path;
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.PoseWpt(1, 1.0, 0.0, 0.0);
+  path.SgmtInitialGuessPoints(1, {Pose2d{1.5, 1.0, 0.0}});
+  path.PoseWpt(2, 2.0, 0.0, 0.0);
+  path.PoseWpt(3, 3.0, 0.0, 0.0);
+  path.ControlIntervalCounts({3, 4, 5});
+
+  auto slice = path.Slice(1, 2);
+  CHECK(slice.GetPath().waypoints.size() == 2);
+  CHECK(slice.GetControlIntervalCounts() == std::vector<size_t>{4});
+
+  // The first waypoint keeps its constraints but loses its segment's
+  CHECK(slice.GetPath().waypoints[0].waypointConstraints.size() ==
+        path.GetPath().waypoints[1].waypointConstraints.size());
+  CHECK(slice.GetPath().waypoints[0].segmentConstraints.empty());
+
+  // The slice's initial guess matches the path's between the two waypoints
+  auto x = slice.CalculateInitialGuess().x;
+  REQUIRE(x.size() == 5);
+  CHECK(x.front() == 1.0);
+  CHECK(x[2] == 1.5);
+  CHECK(x.back() == 2.0);
 }
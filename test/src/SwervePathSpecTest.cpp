@@ -0,0 +1,47 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <memory>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/path/SwervePathSpec.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("SwervePathSpec - Shared by generators", "[SwervePathSpec]") {
+  auto path = trajopt::test::ShortPath();
+
+  int pathCallCount = 0;
+  path.AddIntermediateCallback(
+      [&](trajopt::SwerveSolution&, int64_t) { ++pathCallCount; });
+
+  auto spec = std::make_shared<const trajopt::SwervePathSpec>(std::move(path));
+  CHECK(spec->GetPath().waypoints.size() == 2);
+
+  // The initial guess is calculated once
+  CHECK(&spec->GetInitialGuess() == &spec->GetInitialGuess());
+
+  // Each generator's own callbacks only see its own solves
+  int firstCallCount = 0;
+  int secondCallCount = 0;
+  trajopt::SwerveTrajectoryGenerator first{spec};
+  first.AddIntermediateCallback(
+      [&](trajopt::SwerveSolution&, int64_t) { ++firstCallCount; });
+  trajopt::SwerveTrajectoryGenerator second{spec};
+  second.AddIntermediateCallback(
+      [&](trajopt::SwerveSolution&, int64_t) { ++secondCallCount; });
+
+  REQUIRE(first.Generate().has_value());
+  CHECK(firstCallCount > 0);
+  CHECK(secondCallCount == 0);
+  CHECK(pathCallCount == firstCallCount);
+
+  REQUIRE(second.Generate().has_value());
+  CHECK(secondCallCount > 0);
+  CHECK(pathCallCount == firstCallCount + secondCallCount);
+
+  // The generators reference the spec instead of copying it
+  CHECK(spec.use_count() == 3);
+}
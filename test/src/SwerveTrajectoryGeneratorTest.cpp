@@ -0,0 +1,33 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+TEST_CASE("SwerveTrajectoryGenerator - Three modules",
+          "[SwerveTrajectoryGenerator]") {
+  // Drivetrains without four modules take the general dynamics path
+  trajopt::SwervePathBuilder path;
+  path.SetDrivetrain({.mass = 45,
+                      .moi = 6,
+                      .modules = {{{+0.6, 0.0}, 0.04, 70, 2},
+                                  {{-0.3, +0.5}, 0.04, 70, 2},
+                                  {{-0.3, -0.5}, 0.04, 70, 2}}});
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.PoseWpt(1, 1.0, 1.0, 0.0);
+  path.ControlIntervalCounts({10});
+  path.SetObjective(trajopt::MinimumForceObjective{});
+  path.MaxTotalTime(10.0);
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.Generate();
+  REQUIRE(solution.has_value());
+  REQUIRE(solution->moduleFX.size() == 11);
+  for (size_t index = 0; index < solution->moduleFX.size(); ++index) {
+    CHECK(solution->moduleFX[index].size() == 3);
+    CHECK(solution->moduleFY[index].size() == 3);
+  }
+}
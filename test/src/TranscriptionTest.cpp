@@ -0,0 +1,72 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+#include <numeric>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/DecomposedSwerveTrajectoryGenerator.hpp>
+#include <trajopt/SwerveTrajectoryGenerator.hpp>
+#include <trajopt/objective/Objective.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("Transcription - Builder", "[Transcription]") {
+  auto path = trajopt::test::TwoSegmentPath();
+  CHECK(path.GetPath().transcription == trajopt::Transcription::kFull);
+
+  path.SetTranscription(trajopt::Transcription::kReduced);
+  CHECK(path.GetPath().transcription == trajopt::Transcription::kReduced);
+  CHECK(path.Slice(1, 2).GetPath().transcription ==
+        trajopt::Transcription::kReduced);
+}
+
+TEST_CASE("Transcription - Reduced", "[Transcription]") {
+  auto path = trajopt::test::TwoSegmentPath();
+
+  SECTION("Minimum time") {}
+  SECTION("Time and jerk") {
+    path.SetObjective(trajopt::TimeAndJerkObjective{.jerkWeight = 1e-2});
+  }
+
+  auto full = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(full.has_value());
+
+  // Both transcriptions describe the same problem, so they find the same
+  // trajectory
+  path.SetTranscription(trajopt::Transcription::kReduced);
+  auto reduced = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(reduced.has_value());
+  REQUIRE(reduced->x.size() == full->x.size());
+  REQUIRE(reduced->ax.size() == full->ax.size());
+
+  CHECK(std::accumulate(reduced->dt.begin(), reduced->dt.end(), 0.0) ==
+        Catch::Approx(std::accumulate(full->dt.begin(), full->dt.end(), 0.0))
+            .epsilon(1e-3));
+  for (size_t index = 0; index < full->x.size(); ++index) {
+    CHECK(reduced->x[index] == Catch::Approx(full->x[index]).margin(1e-3));
+    CHECK(reduced->y[index] == Catch::Approx(full->y[index]).margin(1e-3));
+    CHECK(reduced->vx[index] == Catch::Approx(full->vx[index]).margin(1e-3));
+    CHECK(reduced->vy[index] == Catch::Approx(full->vy[index]).margin(1e-3));
+    CHECK(reduced->omega[index] ==
+          Catch::Approx(full->omega[index]).margin(1e-3));
+  }
+}
+
+TEST_CASE("Transcription - Reduced warm start", "[Transcription]") {
+  auto path = trajopt::test::TwoSegmentPath();
+  auto full = trajopt::SwerveTrajectoryGenerator{path}.Generate();
+  REQUIRE(full.has_value());
+
+  // A solution of the full transcription warm starts the reduced one, and the
+  // pieces of a decomposed path keep the transcription
+  path.SetTranscription(trajopt::Transcription::kReduced);
+  trajopt::SwerveTrajectoryGenerator generator{path, *full};
+  CHECK(generator.Generate().has_value());
+
+  trajopt::DecomposedSwerveTrajectoryGenerator decomposed{path, {1}};
+  auto solution = decomposed.Generate();
+  REQUIRE(solution.has_value());
+  CHECK(solution->ax.size() == 21);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <numbers>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/constraint/Constraint.hpp>
+
+namespace {
+
+double Evaluate(const trajopt::Constraint& constraint,
+                const trajopt::Pose2d& pose,
+                const trajopt::Translation2d& linearVelocity = {},
+                double angularVelocity = 0.0) {
+  return trajopt::Evaluate(constraint, pose, linearVelocity, angularVelocity,
+                           {}, 0.0);
+}
+
+}  // namespace
+
+TEST_CASE("Constraint - Evaluate velocity limits", "[Constraint]") {
+  trajopt::Pose2d pose;
+
+  trajopt::LinearVelocityMaxMagnitudeConstraint linear{1.0};
+  CHECK(Evaluate(linear, pose, {0.6, 0.8}) == Catch::Approx(0.0));
+  CHECK(Evaluate(linear, pose, {3.0, 4.0}) == Catch::Approx(4.0));
+
+  trajopt::AngularVelocityMaxMagnitudeConstraint angular{1.0};
+  CHECK(Evaluate(angular, pose, {}, -0.5) == 0.0);
+  CHECK(Evaluate(angular, pose, {}, -1.5) == Catch::Approx(0.5));
+
+  trajopt::LinearVelocityDirectionConstraint direction{std::numbers::pi / 2};
+  CHECK(Evaluate(direction, pose, {0.0, 2.0}) ==
+        Catch::Approx(0.0).margin(1e-12));
+  CHECK(Evaluate(direction, pose, {1.0, 2.0}) == Catch::Approx(1.0));
+}
+
+TEST_CASE("Constraint - Evaluate pose constraints", "[Constraint]") {
+  trajopt::PoseEqualityConstraint poseEquality{1.0, 2.0, 0.0};
+  CHECK(Evaluate(poseEquality, {1.0, 2.0, 0.0}) == Catch::Approx(0.0));
+  CHECK(Evaluate(poseEquality, {1.0, 2.5, 0.0}) == Catch::Approx(0.5));
+  CHECK(Evaluate(poseEquality, {1.0, 2.0, 1.0}) == Catch::Approx(1.0));
+
+  trajopt::TranslationEqualityConstraint translationEquality{1.0, 2.0};
+  CHECK(Evaluate(translationEquality, {4.0, 6.0, 1.0}) == Catch::Approx(5.0));
+
+  trajopt::PointAtConstraint pointAt{{1.0, 0.0}, 0.1};
+  CHECK(Evaluate(pointAt, {0.0, 0.0, 0.05}) == Catch::Approx(0.0));
+  CHECK(Evaluate(pointAt, {0.0, 0.0, std::numbers::pi / 2}) ==
+        Catch::Approx(std::numbers::pi / 2 - 0.1));
+}
+
+TEST_CASE("Constraint - Evaluate obstacle constraints", "[Constraint]") {
+  // Robot line along the robot's front edge
+  trajopt::LinePointConstraint linePoint{
+      {0.5, -0.5}, {0.5, 0.5}, {1.0, 0.0}, 0.2};
+  CHECK(Evaluate(linePoint, {0.0, 0.0, 0.0}) == Catch::Approx(0.0));
+  CHECK(Evaluate(linePoint, {0.4, 0.0, 0.0}) == Catch::Approx(0.1));
+
+  // Rotating the robot by 90° moves the front edge away from the point
+  CHECK(Evaluate(linePoint, {0.4, 0.0, std::numbers::pi / 2}) ==
+        Catch::Approx(0.0));
+
+  trajopt::PointLineConstraint pointLine{
+      {0.0, 0.0}, {1.0, -1.0}, {1.0, 1.0}, 0.5};
+  CHECK(Evaluate(pointLine, {0.8, 3.0, 0.0}) == Catch::Approx(0.0));
+  CHECK(Evaluate(pointLine, {0.8, 0.0, 0.0}) == Catch::Approx(0.3));
+
+  trajopt::PointPointConstraint pointPoint{{1.0, 0.0}, {2.0, 0.0}, 0.5};
+  CHECK(Evaluate(pointPoint, {0.0, 0.0, 0.0}) == Catch::Approx(0.0));
+  CHECK(Evaluate(pointPoint, {0.8, 0.0, 0.0}) == Catch::Approx(0.3));
+}
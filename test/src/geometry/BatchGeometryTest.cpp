@@ -0,0 +1,123 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/constraint/detail/LinePointDistance.hpp>
+#include <trajopt/geometry/BatchGeometry.hpp>
+#include <trajopt/geometry/Rotation2.hpp>
+#include <trajopt/geometry/Translation2.hpp>
+
+namespace {
+
+// Not a multiple of any vector width, so the scalar tail runs too
+constexpr size_t kCount = 103;
+
+std::vector<double> Angles() {
+  std::vector<double> angles;
+  for (size_t i = 0; i < kCount; ++i) {
+    angles.push_back(-20.0 + 40.0 * i / (kCount - 1));
+  }
+
+  // Octant boundaries and signed zeros
+  for (size_t i = 0; i < angles.size() && i < 9; ++i) {
+    angles[i] = (static_cast<double>(i) - 4.0) * std::numbers::pi / 4.0;
+  }
+  angles[9] = 0.0;
+  angles[10] = -0.0;
+  return angles;
+}
+
+}  // namespace
+
+TEST_CASE("BatchGeometry - RotateBy", "[BatchGeometry]") {
+  auto angles = Angles();
+  std::vector<double> x, y, cos, sin;
+  for (size_t i = 0; i < kCount; ++i) {
+    x.push_back(0.1 * i - 3.0);
+    y.push_back(2.0 - 0.05 * i);
+    cos.push_back(std::cos(angles[i]));
+    sin.push_back(std::sin(angles[i]));
+  }
+
+  std::vector<double> rotatedX(kCount), rotatedY(kCount);
+  trajopt::BatchRotateBy(x, y, cos, sin, rotatedX, rotatedY);
+
+  for (size_t i = 0; i < kCount; ++i) {
+    auto expected = trajopt::Translation2d{x[i], y[i]}.RotateBy(
+        trajopt::Rotation2d{cos[i], sin[i]});
+    CHECK(rotatedX[i] == Catch::Approx(expected.X()).margin(1e-15));
+    CHECK(rotatedY[i] == Catch::Approx(expected.Y()).margin(1e-15));
+  }
+
+  // In place
+  trajopt::BatchRotateBy(x, y, cos, sin, x, y);
+  CHECK(x == rotatedX);
+  CHECK(y == rotatedY);
+}
+
+TEST_CASE("BatchGeometry - LinePointSquaredDistance", "[BatchGeometry]") {
+  trajopt::Translation2d lineStart{-1.0, 0.5};
+  trajopt::Translation2d lineEnd{2.0, -1.5};
+
+  std::vector<double> x, y;
+  for (size_t i = 0; i < kCount; ++i) {
+    x.push_back(0.07 * i - 4.0);
+    y.push_back(std::sin(0.3 * i) * 3.0);
+  }
+
+  std::vector<double> squaredDistances(kCount);
+  trajopt::BatchLinePointSquaredDistance(lineStart, lineEnd, x, y,
+                                         squaredDistances);
+
+  for (size_t i = 0; i < kCount; ++i) {
+    double expected = trajopt::detail::LinePointSquaredDistance(
+        lineStart, lineEnd, trajopt::Translation2d{x[i], y[i]});
+    CHECK(squaredDistances[i] == Catch::Approx(expected).margin(1e-14));
+  }
+}
+
+TEST_CASE("BatchGeometry - Radians", "[BatchGeometry]") {
+  auto angles = Angles();
+  std::vector<double> cos, sin;
+  for (double angle : angles) {
+    cos.push_back(std::cos(angle));
+    sin.push_back(std::sin(angle));
+  }
+
+  // Points off the unit circle and on the axes
+  cos[11] = 0.0;
+  sin[11] = 0.0;
+  cos[12] = -0.0;
+  sin[12] = 0.0;
+  cos[13] = 3.0;
+  sin[13] = -4.0;
+  cos[14] = 0.0;
+  sin[14] = -2.0;
+
+  std::vector<double> radians(kCount);
+  trajopt::BatchRadians(cos, sin, radians);
+
+  for (size_t i = 0; i < kCount; ++i) {
+    double expected = trajopt::Rotation2d{cos[i], sin[i]}.Radians();
+    CHECK(radians[i] == Catch::Approx(expected).margin(1e-15));
+    CHECK(std::signbit(radians[i]) == std::signbit(expected));
+  }
+}
+
+TEST_CASE("BatchGeometry - CosSin", "[BatchGeometry]") {
+  auto angles = Angles();
+
+  std::vector<double> cos(kCount), sin(kCount);
+  trajopt::BatchCosSin(angles, cos, sin);
+
+  for (size_t i = 0; i < kCount; ++i) {
+    CHECK(cos[i] == Catch::Approx(std::cos(angles[i])).margin(1e-15));
+    CHECK(sin[i] == Catch::Approx(std::sin(angles[i])).margin(1e-15));
+  }
+  CHECK(std::signbit(sin[10]));
+}
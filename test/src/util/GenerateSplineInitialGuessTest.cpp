@@ -0,0 +1,54 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/solution/SwerveSolution.hpp>
+#include <trajopt/util/GenerateSplineInitialGuess.hpp>
+
+TEST_CASE("GenerateSplineInitialGuess - Evenly spaced line", "[TrajoptUtil]") {
+  // Evenly spaced collinear knots give the same guess as linear interpolation
+  std::vector<std::vector<trajopt::Pose2d>> initialGuessPoints{
+      {{1, 0, 0}}, {{2, 0, 0}, {3, 0, 0}}, {{4, 0, 0}}};
+  std::vector<size_t> controlIntervalCounts{2, 2};
+  std::vector<double> expectedX{1, 2, 3, 3.5, 4};
+  auto result = trajopt::GenerateSplineInitialGuess<trajopt::SwerveSolution>(
+      initialGuessPoints, controlIntervalCounts);
+  REQUIRE(result.x.size() == expectedX.size());
+  for (size_t i = 0; i < expectedX.size(); ++i) {
+    CHECK(result.x[i] == Catch::Approx(expectedX[i]));
+    CHECK(result.y[i] == Catch::Approx(0.0).margin(1e-12));
+  }
+}
+
+TEST_CASE("GenerateSplineInitialGuess - Smooth corner", "[TrajoptUtil]") {
+  std::vector<std::vector<trajopt::Pose2d>> initialGuessPoints{
+      {{0, 0, 0}}, {{1, 0, 0}}, {{1, 1, 0}}};
+  std::vector<size_t> controlIntervalCounts{20, 20};
+  auto result = trajopt::GenerateSplineInitialGuess<trajopt::SwerveSolution>(
+      initialGuessPoints, controlIntervalCounts);
+
+  // The direction of travel changes gradually through the corner at (1, 0)
+  // instead of turning 90° at once
+  auto direction = [&](size_t i) {
+    return std::atan2(result.y[i] - result.y[i - 1],
+                      result.x[i] - result.x[i - 1]);
+  };
+  CHECK(std::abs(direction(21) - direction(20)) < 0.5);
+  CHECK(result.x[20] == Catch::Approx(1.0));
+  CHECK(result.y[20] == Catch::Approx(0.0).margin(1e-12));
+}
+
+TEST_CASE("GenerateSplineInitialGuess - Heading wraps", "[TrajoptUtil]") {
+  // Turning from just under π to just over -π goes the short way around
+  std::vector<std::vector<trajopt::Pose2d>> initialGuessPoints{
+      {{0, 0, 3.0}}, {{1, 0, -3.0}}};
+  std::vector<size_t> controlIntervalCounts{4};
+  auto result = trajopt::GenerateSplineInitialGuess<trajopt::SwerveSolution>(
+      initialGuessPoints, controlIntervalCounts);
+  for (size_t i = 0; i < result.thetacos.size(); ++i) {
+    CHECK(result.thetacos[i] < std::cos(3.0) + 1e-9);
+  }
+}
@@ -0,0 +1,100 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/util/InitialGuessPlanner.hpp>
+
+namespace {
+
+constexpr double kHalfLength = 0.35;
+constexpr double kHalfWidth = 0.35;
+
+trajopt::Bumpers SquareBumpers() {
+  return trajopt::Bumpers{.safetyDistance = 0.1,
+                          .points = {{+kHalfLength, +kHalfWidth},
+                                     {-kHalfLength, +kHalfWidth},
+                                     {-kHalfLength, -kHalfWidth},
+                                     {+kHalfLength, -kHalfWidth}}};
+}
+
+/// Radius of the circle the planner keeps the robot's center outside of.
+double InflatedRadius(double obstacleSafetyDistance) {
+  return std::hypot(kHalfLength, kHalfWidth) + 0.1 + obstacleSafetyDistance;
+}
+
+}  // namespace
+
+TEST_CASE("InitialGuessPlanner - Straight line when unobstructed",
+          "[InitialGuessPlanner]") {
+  trajopt::InitialGuessPlanner planner{
+      {SquareBumpers()},
+      {trajopt::Obstacle{.safetyDistance = 0.5, .points = {{2.0, 3.0}}}}};
+
+  auto corners = planner.Plan({0.0, 0.0}, {4.0, 0.0});
+  REQUIRE(corners.has_value());
+  CHECK(corners->empty());
+}
+
+TEST_CASE("InitialGuessPlanner - Route around obstacle",
+          "[InitialGuessPlanner]") {
+  trajopt::Obstacle obstacle{.safetyDistance = 0.5, .points = {{2.0, 0.0}}};
+  trajopt::InitialGuessPlanner planner{{SquareBumpers()}, {obstacle}};
+
+  trajopt::Translation2d start{0.0, 0.0};
+  trajopt::Translation2d goal{4.0, 0.0};
+  auto corners = planner.Plan(start, goal);
+  REQUIRE(corners.has_value());
+  REQUIRE_FALSE(corners->empty());
+
+  // Walk the polyline finely and check it never enters the inflated obstacle
+  std::vector<trajopt::Translation2d> polyline{start};
+  polyline.insert(polyline.end(), corners->begin(), corners->end());
+  polyline.push_back(goal);
+  for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+    for (int step = 0; step <= 100; ++step) {
+      auto point =
+          polyline[i] + (polyline[i + 1] - polyline[i]) * (step / 100.0);
+      CHECK(point.Distance(obstacle.points[0]) >=
+            InflatedRadius(obstacle.safetyDistance));
+    }
+  }
+}
+
+TEST_CASE("InitialGuessPlanner - Blocked goal", "[InitialGuessPlanner]") {
+  // Surround the goal with a ring of obstacles too close together to pass
+  // between
+  std::vector<trajopt::Obstacle> obstacles;
+  for (int i = 0; i < 24; ++i) {
+    double angle = 2.0 * std::numbers::pi * i / 24;
+    obstacles.push_back(
+        {.safetyDistance = 0.5,
+         .points = {{4.0 + 3.0 * std::cos(angle), 3.0 * std::sin(angle)}}});
+  }
+  trajopt::InitialGuessPlanner planner{{SquareBumpers()}, obstacles};
+
+  CHECK_FALSE(planner.Plan({-5.0, 0.0}, {4.0, 0.0}).has_value());
+}
+
+TEST_CASE("InitialGuessPlanner - Path builder routes initial guess",
+          "[InitialGuessPlanner]") {
+  trajopt::SwervePathBuilder path;
+  path.PoseWpt(0, 0.0, 0.0, 0.0);
+  path.PoseWpt(1, 4.0, 0.0, 0.0);
+  path.AddBumpers(SquareBumpers());
+
+  trajopt::Obstacle obstacle{.safetyDistance = 0.5, .points = {{2.0, 0.0}}};
+  path.SgmtObstacle(0, 1, obstacle);
+  path.ControlIntervalCounts({40});
+
+  auto guess = path.CalculateInitialGuess();
+  REQUIRE(guess.x.size() == 41);
+  for (size_t index = 0; index < guess.x.size(); ++index) {
+    trajopt::Translation2d point{guess.x[index], guess.y[index]};
+    CHECK(point.Distance(obstacle.points[0]) >=
+          InflatedRadius(obstacle.safetyDistance));
+  }
+}
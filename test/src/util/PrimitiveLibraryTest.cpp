@@ -0,0 +1,84 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/util/PrimitiveLibrary.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("PrimitiveLibrary - Nearest primitive", "[PrimitiveLibrary]") {
+  trajopt::PrimitiveLibrary library{trajopt::test::Drivetrain()};
+  CHECK(library.Nearest({0, 0, 0}, {1, 0, 0}) == nullptr);
+
+  // Add straight-line primitives of several lengths and directions
+  for (double length : {1.0, 2.0, 3.0, 4.0}) {
+    for (double angle : {0.0, std::numbers::pi / 2}) {
+      trajopt::Pose2d end{length * std::cos(angle), length * std::sin(angle),
+                          0.0};
+      auto path = trajopt::test::PosePath({{0, 0, 0}, end}, {10});
+      REQUIRE(library.Add(path.CalculateInitialGuess(),
+                          path.GetControlIntervalCounts()));
+    }
+  }
+  CHECK(library.Size() == 8);
+
+  // The nearest primitive is found relative to the start pose, so a segment
+  // starting elsewhere facing +y matches the primitive driving forward
+  const auto* primitive = library.Nearest({5, 5, std::numbers::pi / 2},
+                                          {5, 7.1, std::numbers::pi / 2});
+  REQUIRE(primitive != nullptr);
+  CHECK(primitive->delta.X() == Catch::Approx(2.0));
+  CHECK(primitive->delta.Y() == Catch::Approx(0.0).margin(1e-9));
+}
+
+TEST_CASE("PrimitiveLibrary - Initial guess", "[PrimitiveLibrary]") {
+  trajopt::PrimitiveLibrary library{trajopt::test::Drivetrain()};
+  auto solved = trajopt::test::PosePath({{0, 0, 0}, {3, 1, 0.5}}, {20});
+  auto solvedGuess = solved.CalculateInitialGuess();
+  REQUIRE(library.Add(solvedGuess, solved.GetControlIntervalCounts()));
+
+  // Same shape, moved and rotated by 90°, with a different sample count and a
+  // slightly different end
+  auto path = trajopt::test::PosePath(
+      {{2, 2, std::numbers::pi / 2}, {1, 5.1, std::numbers::pi / 2 + 0.5}},
+      {40});
+  auto guess = library.InitialGuess(path);
+  REQUIRE(guess.has_value());
+  REQUIRE(guess->x.size() == 41);
+  REQUIRE(guess->vx.size() == 41);
+
+  // Passes through both waypoints
+  CHECK(guess->x.front() == Catch::Approx(2.0));
+  CHECK(guess->y.front() == Catch::Approx(2.0));
+  CHECK(guess->x.back() == Catch::Approx(1.0));
+  CHECK(guess->y.back() == Catch::Approx(5.1));
+
+  // Velocities are the primitive's rotated by 90°
+  CHECK(guess->vx[20] == Catch::Approx(-solvedGuess.vy[10]));
+  CHECK(guess->vy[20] == Catch::Approx(solvedGuess.vx[10]));
+
+  // The segment takes as long as the primitive
+  double totalTime = 0.0;
+  for (size_t index = 1; index < guess->dt.size(); ++index) {
+    totalTime += guess->dt[index];
+  }
+  double solvedTime = 0.0;
+  for (size_t index = 1; index < solvedGuess.dt.size(); ++index) {
+    solvedTime += solvedGuess.dt[index];
+  }
+  CHECK(totalTime == Catch::Approx(solvedTime));
+}
+
+TEST_CASE("PrimitiveLibrary - Mismatched drivetrain", "[PrimitiveLibrary]") {
+  auto drivetrain = trajopt::test::Drivetrain();
+  drivetrain.mass = 60;
+  trajopt::PrimitiveLibrary library{drivetrain};
+
+  auto path = trajopt::test::PosePath({{0, 0, 0}, {1, 0, 0}}, {10});
+  CHECK_FALSE(library.InitialGuess(path).has_value());
+}
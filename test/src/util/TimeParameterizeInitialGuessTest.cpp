@@ -0,0 +1,62 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/util/TimeParameterizeInitialGuess.hpp>
+#include <trajopt/util/ValidateTrajectory.hpp>
+
+#include "TestPaths.hpp"
+
+TEST_CASE("TimeParameterizeInitialGuess - Respects drivetrain limits",
+          "[TimeParameterizeInitialGuess]") {
+  auto path = trajopt::test::StraightPath();
+  auto guess = path.CalculateInitialGuess();
+
+  auto validation = trajopt::ValidateTrajectory(
+      guess, path.GetPath(), path.GetControlIntervalCounts());
+  REQUIRE(validation.has_value());
+  CHECK(validation->IsValid());
+
+  // Starts at rest and decelerates to a stop at the end
+  CHECK(guess.vx.front() == 0.0);
+  CHECK(guess.vx.back() < guess.vx[guess.vx.size() / 2]);
+  CHECK(guess.ax.back() < 0.0);
+}
+
+TEST_CASE("TimeParameterizeInitialGuess - Consistent kinematics",
+          "[TimeParameterizeInitialGuess]") {
+  auto path = trajopt::test::StraightPath();
+  auto guess = path.CalculateInitialGuess();
+
+  // Each segment's samples share one dt, like the generator's decision
+  // variables
+  const auto& N = path.GetControlIntervalCounts();
+  REQUIRE(guess.dt.size() == guess.x.size());
+  for (size_t index = 2; index <= N[0]; ++index) {
+    CHECK(guess.dt[index] == Catch::Approx(guess.dt[1]));
+  }
+  CHECK(guess.dt[1] > 0.0);
+
+  for (size_t index = 1; index < guess.x.size(); ++index) {
+    double dt = guess.dt[index];
+    CHECK(guess.x[index - 1] + guess.vx[index] * dt ==
+          Catch::Approx(guess.x[index]).margin(1e-9));
+    CHECK(guess.vx[index - 1] + guess.ax[index] * dt ==
+          Catch::Approx(guess.vx[index]).margin(1e-9));
+    CHECK(guess.omega[index - 1] + guess.alpha[index] * dt ==
+          Catch::Approx(guess.omega[index]).margin(1e-9));
+  }
+}
+
+TEST_CASE("TimeParameterizeInitialGuess - No drivetrain",
+          "[TimeParameterizeInitialGuess]") {
+  trajopt::SwerveSolution guess;
+  guess.x = {0.0, 1.0};
+  auto result = trajopt::TimeParameterizeInitialGuess(guess, {}, {1});
+  CHECK(result.x == guess.x);
+  CHECK(result.vx.empty());
+}
@@ -0,0 +1,183 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/obstacle/FieldModel.hpp>
+#include <trajopt/path/SwervePathBuilder.hpp>
+#include <trajopt/solution/SwerveSolution.hpp>
+#include <trajopt/util/ValidateTrajectory.hpp>
+
+#include "TestPaths.hpp"
+
+namespace {
+
+// Returns a path to (2, 0) in four control intervals that stops at the origin,
+// with an obstacle at (1, 1) for a point robot.
+trajopt::SwervePathBuilder ObstaclePath() {
+  auto path = trajopt::test::PosePath({{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}}, {4});
+  trajopt::test::StopAt(path, 0);
+  path.AddBumpers(trajopt::Bumpers{.safetyDistance = 0.0, .points = {{}}});
+  path.SgmtObstacle(0, 1,
+                    trajopt::Obstacle{.safetyDistance = 0.1,
+                                      .points = {{1.0, 1.0}}});
+  return path;
+}
+
+// Returns a stationary solution at the origin with the given sample count.
+trajopt::SwerveSolution MakeSolution(size_t sampTot) {
+  std::vector<double> zeros(sampTot, 0.0);
+  return trajopt::SwerveSolution{
+      std::vector<double>(sampTot - 1, 0.1),
+      zeros,
+      zeros,
+      std::vector<double>(sampTot, 1.0),
+      zeros,
+      zeros,
+      zeros,
+      zeros,
+      zeros,
+      zeros,
+      zeros,
+      std::vector<std::vector<double>>(sampTot, std::vector<double>(4, 0.0)),
+      std::vector<std::vector<double>>(sampTot, std::vector<double>(4, 0.0))};
+}
+
+// Returns a solution that drives in a straight line from (0, 0) to (2, 0) in
+// four 0.4 s steps, accelerating at 3.125 m/s² and then decelerating.
+trajopt::SwerveSolution MakeDrive() {
+  auto solution = MakeSolution(5);
+  solution.dt = {0.4, 0.4, 0.4, 0.4};
+  solution.x = {0.0, 0.5, 1.5, 2.0, 2.0};
+  solution.vx = {0.0, 1.25, 2.5, 1.25, 0.0};
+  solution.ax = {0.0, 3.125, 3.125, -3.125, -3.125};
+
+  // Each of the four modules pushes with a quarter of 45 kg × ax
+  for (size_t index = 0; index < solution.ax.size(); ++index) {
+    solution.moduleFX[index].assign(4, 45.0 * solution.ax[index] / 4.0);
+  }
+  return solution;
+}
+
+}  // namespace
+
+TEST_CASE("ValidateTrajectory - Satisfied and violated constraints",
+          "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  auto solution = MakeDrive();
+
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->IsValid());
+
+  // Exceed the first waypoint's zero velocity constraint
+  solution.vx[0] = 0.5;
+
+  // Exceed the first module's force limit of 2 N−m / 0.04 m = 50 N
+  solution.moduleFX[2][0] = 60.0;
+
+  result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                       path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK_FALSE(result->IsValid());
+  CHECK(result->moduleForce[2] == Catch::Approx(10.0));
+  CHECK(result->samples[0] == Catch::Approx(0.5));
+  CHECK(result->MaxViolation() == Catch::Approx(60.0 - 45.0 * 3.125 / 4.0));
+}
+
+TEST_CASE("ValidateTrajectory - Kinematics", "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  auto solution = MakeDrive();
+
+  // Move the third sample 0.1 m ahead of where its velocity integrates to
+  solution.x[2] += 0.1;
+
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK_FALSE(result->IsValid());
+  CHECK(result->kinematics[1] == Catch::Approx(0.0).margin(1e-12));
+  CHECK(result->kinematics[2] == Catch::Approx(0.1));
+  CHECK(result->kinematics[3] == Catch::Approx(0.1));
+  CHECK(result->MaxViolation() == Catch::Approx(0.1));
+}
+
+TEST_CASE("ValidateTrajectory - Time bounds", "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  path.MaxTotalTime(1.0);
+  auto solution = MakeDrive();
+
+  // The 1.6 s drive takes longer than the maximum
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->totalTime == Catch::Approx(0.6));
+  CHECK(result->MaxViolation() == Catch::Approx(0.6));
+
+  // In 0.5 s the wheels travel 0.5 s × 2.8 m/s = 1.4 m, farther than the
+  // modules' 1.2 m spacing, and a step can't go back in time
+  solution.dt[1] = 0.5;
+  solution.dt[2] = -0.1;
+
+  result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                       path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->timeStep[1] == Catch::Approx(0.0).margin(1e-12));
+  CHECK(result->timeStep[2] == Catch::Approx(0.2));
+  CHECK(result->timeStep[3] == Catch::Approx(0.1));
+}
+
+TEST_CASE("ValidateTrajectory - Obstacle", "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  auto solution = MakeSolution(5);
+
+  // Drive through the obstacle at (1, 1)
+  solution.x = {0.0, 0.5, 1.0, 1.5, 2.0};
+  solution.y = {0.0, 0.5, 1.0, 0.5, 0.0};
+
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->segmentConstraints.at(0).violation == Catch::Approx(0.1));
+  CHECK(result->segmentConstraints.at(0).sampleIndex == 2);
+}
+
+TEST_CASE("ValidateTrajectory - Field obstacles", "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  auto solution = MakeDrive();
+
+  // An obstacle 0.05 m inside the safety distance of the drive's last sample,
+  // and one too far away to be checked
+  path.SetField(std::make_shared<const trajopt::FieldModel>(
+      std::vector{trajopt::Obstacle{.safetyDistance = 0.2,
+                                    .points = {{2.0, 0.15}}},
+                  trajopt::Obstacle{.safetyDistance = 0.2,
+                                    .points = {{20.0, 20.0}}}}));
+
+  // Only segments that avoid the field check it
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->IsValid());
+
+  path.SgmtFieldObstacles(0, 1, 1.0);
+  result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                       path.GetControlIntervalCounts());
+  REQUIRE(result.has_value());
+  CHECK(result->fieldObstacles[2] == 0.0);
+  CHECK(result->fieldObstacles[4] == Catch::Approx(0.05));
+  CHECK(result->MaxViolation() == Catch::Approx(0.05));
+}
+
+TEST_CASE("ValidateTrajectory - Mismatched sample count",
+          "[ValidateTrajectory]") {
+  auto path = ObstaclePath();
+  auto solution = MakeSolution(4);
+
+  auto result = trajopt::ValidateTrajectory(solution, path.GetPath(),
+                                            path.GetControlIntervalCounts());
+  CHECK_FALSE(result.has_value());
+}